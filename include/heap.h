@@ -107,6 +107,30 @@ typedef struct st_heap_block
   ulong last_allocated; /* number of records there is allocated space for */
 } HP_BLOCK;
 
+/*
+  Records with long VARCHAR or with BLOB columns are stored in two parts.
+  The columns in front of the first such column that follows all key
+  segments are kept in the record block, as for other tables. The rest
+  of the record is packed, with VARCHAR and BLOB columns taking only the
+  bytes of their values, and stored in a chain of chunks. Keys never
+  look at the chunks.
+*/
+
+enum hp_column_type
+{
+  HP_COLUMN_FIXED,			/* Stored with its full length */
+  HP_COLUMN_VARCHAR,			/* Length bytes + used part */
+  HP_COLUMN_BLOB			/* Length bytes + data of pointer */
+};
+
+typedef struct st_hp_columndef		/* Column of the packed part */
+{
+  uint offset;				/* Offset of column in record */
+  uint length;				/* Length of column in record */
+  uint8 type;				/* enum hp_column_type */
+  uint8 length_bytes;			/* Bytes storing length of value */
+} HP_COLUMNDEF;
+
 struct st_heap_info;			/* For referense */
 
 typedef struct st_hp_keydef		/* Key definition with open */
@@ -133,7 +157,9 @@ typedef struct st_hp_keydef		/* Key definition with open */
 typedef struct st_heap_share
 {
   HP_BLOCK block;
+  HP_BLOCK chunk_block;			/* Chunks of packed record parts */
   HP_KEYDEF  *keydef;
+  HP_COLUMNDEF *columndef;		/* Columns of the packed part */
   ulong min_records,max_records;	/* Params to open */
   ulonglong data_length,index_length,max_table_size;
   uint key_stat_version;                /* version to indicate insert/delete */
@@ -141,6 +167,11 @@ typedef struct st_heap_share
   uint blength;				/* records rounded up to 2^n */
   uint deleted;				/* Deleted records in database */
   uint reclength;			/* Length of one record */
+  uint fixed_length;			/* Bytes of record in record block */
+  uint visible;				/* Offset of the not-deleted flag */
+  uint columns;				/* Columns in columndef, 0 if none */
+  ulong chunks;				/* Chunks allocated in chunk_block */
+  uchar *chunk_del_link;		/* Link to next free chunk */
   uint changed;
   uint keys,max_key_length;
   uint currently_disabled_keys;    /* saved value from "keys" when disabled */
@@ -169,6 +200,9 @@ typedef struct st_heap_info
   uint opt_flag,update;
   uchar *lastkey;			/* Last used key with rkey */
   uchar *recbuf;                         /* Record buffer for rb-tree keys */
+  uchar *pack_buff;			/* Packed part of record to write */
+  uchar *unpack_buff;			/* Packed part of record read */
+  size_t pack_buff_length, unpack_buff_length;
   enum ha_rkey_function last_find_flag;
   TREE_ELEMENT *parents[MAX_TREE_HEIGHT+1];
   TREE_ELEMENT **last_pos;
@@ -182,6 +216,12 @@ typedef struct st_heap_info
 typedef struct st_heap_create_info
 {
   HP_KEYDEF *keydef;
+  /*
+    All columns of the record, ordered by offset, or NULL. Used to store
+    records with long VARCHAR and BLOB columns in a packed format.
+  */
+  HP_COLUMNDEF *columndef;
+  uint columns;
   ulong max_records;
   ulong min_records;
   uint auto_key;                        /* keynr [1 - maxkey] for auto key */
@@ -216,6 +256,8 @@ extern int heap_info(HP_INFO *info,HEAPINFO *x,int flag);
 extern int heap_create(const char *name,
                        HP_CREATE_INFO *create_info, HP_SHARE **share,
                        my_bool *created_new_share);
+extern my_bool heap_packed_record(const HP_CREATE_INFO *create_info,
+                                  uint *fixed_length);
 extern int heap_delete_table(const char *name);
 extern void heap_drop_table(HP_INFO *info);
 extern int heap_extra(HP_INFO *info,enum ha_extra_function function);
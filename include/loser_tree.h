@@ -0,0 +1,254 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef LOSER_TREE_INCLUDED
+#define LOSER_TREE_INCLUDED
+
+#include "my_dbug.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+/**
+  Implements a tournament tree of losers, for k-way merging.
+
+  Every element (player) is a leaf of a complete binary tree, and every
+  inner node remembers the player that lost the match played there.
+  The overall winner is kept above the root. When the winner changes
+  priority, or is removed, only the matches on the path from its leaf
+  to the root are replayed. This takes log2(k) comparisons, while a
+  binary heap needs up to two comparisons per level to restore its
+  property after the top element has changed.
+
+  Unlike a heap, the set of players is fixed once the tree is built:
+  players are added with push(), then build() plays the initial
+  tournament. Afterwards the winner is accessed with top(), and must be
+  followed by update_top() if its priority changes, or pop() if it
+  leaves the tournament.
+
+  We provide iterators, which can be used to visit all players still in
+  the tournament. Iterators do not visit players in priority order.
+
+  @tparam T         Type of the players.
+  @tparam Less      A binary predicate with the same meaning as for
+                    Priority_queue: top() is the greatest element, so
+                    less(a,b) shall return true if b goes before a.
+  @tparam Allocator Allocator for the arrays of the tree.
+ */
+template
+<
+  typename T,
+  typename Less = std::less<T>,
+  typename Allocator = std::allocator<T>
+>
+class Loser_tree : public Less
+{
+public:
+  typedef std::vector<T, Allocator> container_type;
+  typedef Less      less_type;
+  typedef T         value_type;
+  typedef typename container_type::size_type size_type;
+  typedef typename container_type::iterator iterator;
+  typedef typename container_type::const_iterator const_iterator;
+
+private:
+  // Deriving from Less allows empty base-class optimization in some cases.
+  typedef Less Base;
+
+  typedef typename Allocator::template rebind<size_type>::other
+    Index_allocator;
+  typedef std::vector<size_type, Index_allocator> Index_vector;
+
+  /// Slot of a player that has left the tournament.
+  static size_type out_slot() { return static_cast<size_type>(-1); }
+
+  /// Returns the number of leaves, i.e. of players pushed.
+  size_type num_leaves() const { return m_slot.size(); }
+
+  /// Returns true if the player at leaf a wins the match against leaf b.
+  bool beats(size_type a, size_type b)
+  {
+    if (m_slot[a] == out_slot())
+      return false;
+    if (m_slot[b] == out_slot())
+      return true;
+    return !Base::operator()(m_players[m_slot[a]], m_players[m_slot[b]]);
+  }
+
+  /**
+    Plays the matches of the subtree below node, storing the losers
+    in the inner nodes.
+
+    @returns the leaf of the winner of the subtree.
+  */
+  size_type play(size_type node)
+  {
+    if (node >= num_leaves())
+      return node - num_leaves();
+    const size_type left= play(2 * node);
+    const size_type right= play(2 * node + 1);
+    if (beats(left, right))
+    {
+      m_nodes[node]= right;
+      return left;
+    }
+    m_nodes[node]= left;
+    return right;
+  }
+
+  /// Replays the matches from the given leaf up to the root.
+  void replay(size_type leaf)
+  {
+    size_type winner= leaf;
+    for (size_type node= (num_leaves() + leaf) / 2; node > 0; node/= 2)
+    {
+      if (beats(m_nodes[node], winner))
+        std::swap(m_nodes[node], winner);
+    }
+    m_nodes[0]= winner;
+  }
+
+public:
+  explicit Loser_tree(Less const &less = Less(),
+                      Allocator const &alloc = Allocator())
+    : Base(less),
+      m_players(alloc),
+      m_leaf(Index_allocator(alloc)),
+      m_slot(Index_allocator(alloc)),
+      m_nodes(Index_allocator(alloc))
+  {}
+
+  /**
+    Reserves space for players.
+
+    @param  n number of players.
+    @retval true if out-of-memory, false otherwise.
+  */
+  __attribute__((warn_unused_result))
+  bool reserve(size_type n)
+  {
+    try
+    {
+      m_players.reserve(n);
+      m_leaf.reserve(n);
+      m_slot.reserve(n);
+      m_nodes.reserve(n);
+    }
+    catch(std::bad_alloc const &)
+    {
+      return true;
+    }
+    return false;
+  }
+
+  /**
+    Adds a player to the tournament. Must be called before build().
+
+    @param  x value to be added.
+    @retval true if out-of-memory, false otherwise.
+  */
+  bool push(value_type const &x)
+  {
+    try
+    {
+      m_players.push_back(x);
+      m_leaf.push_back(m_slot.size());
+      m_slot.push_back(m_players.size() - 1);
+      m_nodes.push_back(0);
+    }
+    catch(std::bad_alloc const &)
+    {
+      return true;
+    }
+    return false;
+  }
+
+  /// Plays the initial tournament between all players.
+  void build()
+  {
+    DBUG_ASSERT(m_players.size() == num_leaves());
+    if (!empty())
+      m_nodes[0]= play(1);
+  }
+
+  /// Returns a reference to the current winner.
+  value_type& top()
+  {
+    DBUG_ASSERT(!empty());
+    return m_players[m_slot[m_nodes[0]]];
+  }
+
+  /// Returns a const reference to the current winner.
+  value_type const &top() const
+  {
+    DBUG_ASSERT(!empty());
+    return m_players[m_slot[m_nodes[0]]];
+  }
+
+  /// Restores the tournament after the priority of top() has changed.
+  void update_top()
+  {
+    DBUG_ASSERT(!empty());
+    replay(m_nodes[0]);
+  }
+
+  /// Removes the current winner from the tournament.
+  void pop()
+  {
+    DBUG_ASSERT(!empty());
+    const size_type winner= m_nodes[0];
+    const size_type slot= m_slot[winner];
+    // Move the last player into the slot of the winner.
+    m_players[slot]= m_players.back();
+    m_leaf[slot]= m_leaf.back();
+    m_slot[m_leaf[slot]]= slot;
+    m_players.pop_back();
+    m_leaf.pop_back();
+    m_slot[winner]= out_slot();
+    replay(winner);
+  }
+
+  /// Returns the number of players still in the tournament.
+  size_type size() const { return m_players.size(); }
+
+  /// Returns true if no players are left in the tournament.
+  bool empty() const { return m_players.empty(); }
+
+  /// Returns an iterator to the first player still in the tournament.
+  iterator begin() { return m_players.begin(); }
+
+  /// Returns an iterator to the end of the players in the tournament.
+  iterator end() { return m_players.end(); }
+
+  /// Returns a const iterator to the first player still in the tournament.
+  const_iterator begin() const { return m_players.begin(); }
+
+  /// Returns a const iterator to the end of the players in the tournament.
+  const_iterator end() const { return m_players.end(); }
+
+private:
+  container_type m_players;   ///< Players still in the tournament.
+  Index_vector   m_leaf;      ///< m_leaf[i] is the leaf of m_players[i].
+  /// m_slot[leaf] is the index in m_players, or out_slot().
+  Index_vector   m_slot;
+  /// m_nodes[0] is the winning leaf, m_nodes[1..k-1] the losing leaves.
+  Index_vector   m_nodes;
+};
+
+#endif  // LOSER_TREE_INCLUDED
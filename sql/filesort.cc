@@ -35,7 +35,7 @@
 #include "sql_optimizer.h"              // JOIN
 #include "sql_base.h"
 #include "opt_costmodel.h"
-#include "priority_queue.h"
+#include "loser_tree.h"
 #include "log.h"
 #include "item_sum.h"                   // Item_sum
 #include "json_dom.h"                   // Json_wrapper
@@ -87,6 +87,13 @@ static int merge_index(Sort_param *param,
                        Merge_chunk_array chunk_array,
                        IO_CACHE *tempfile,
                        IO_CACHE *outfile);
+static uint merge_fanin(const Sort_param *param, size_t buffer_size);
+static int merge_chunks_to_fanin(Sort_param *param, Sort_buffer sort_buffer,
+                                 Merge_chunk_array chunk_array, uint fanin,
+                                 size_t *p_num_chunks, IO_CACHE *t_file,
+                                 uint *merge_passes, uint *file_rewrites);
+static void merge_many_buff_passes(size_t num_chunks, uint *merge_passes,
+                                   uint *file_rewrites);
 static bool save_index(Sort_param *param, uint count,
                        Filesort_info *table_sort);
 static uint suffix_length(ulong string_length);
@@ -307,6 +314,7 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
                           table,
                           thd->variables.max_length_for_sort_data,
                           max_rows, sort_positions);
+  param.sort_threads= thd->variables.sort_threads;
 
   table_sort.addon_fields= param.addon_fields;
 
@@ -471,11 +479,22 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
     param.max_keys_per_buffer=
       table_sort.sort_buffer_size() / param.rec_length;
 
-    if (merge_many_buff(&param,
-                        table_sort.get_raw_buf(),
-                        table_sort.merge_chunks,
-                        &num_chunks,
-                        &tempfile))
+    /*
+      Merge as many chunks at a time as the sort buffer has room for,
+      so that fewer passes over the sort file are needed before the
+      final merge into outfile; usually none at all.
+    */
+    const uint fanin= merge_fanin(&param, table_sort.sort_buffer_size());
+    const my_off_t sort_file_size= my_b_tell(&tempfile);
+    uint merge_passes, file_rewrites;
+    if (merge_chunks_to_fanin(&param,
+                              table_sort.get_raw_buf(),
+                              table_sort.merge_chunks,
+                              fanin,
+                              &num_chunks,
+                              &tempfile,
+                              &merge_passes,
+                              &file_rewrites))
       goto err;
     if (flush_io_cache(&tempfile) ||
 	reinit_io_cache(&tempfile,READ_CACHE,0L,0,0))
@@ -487,6 +506,17 @@ bool filesort(THD *thd, Filesort *filesort, bool sort_positions,
                     &tempfile,
                     outfile))
       goto err;
+
+    // Report what merging MERGEBUFF chunks at a time would have cost.
+    uint old_merge_passes, old_file_rewrites;
+    merge_many_buff_passes(table_sort.merge_chunks.size(),
+                           &old_merge_passes, &old_file_rewrites);
+    DBUG_ASSERT(old_merge_passes >= merge_passes);
+    DBUG_ASSERT(old_file_rewrites >= file_rewrites);
+    thd->status_var.filesort_merge_saved_passes+=
+      old_merge_passes - merge_passes;
+    thd->status_var.filesort_merge_saved_bytes+=
+      (old_file_rewrites - file_rewrites) * sort_file_size;
   }
 
   if (num_rows > param.max_rows)
@@ -1896,6 +1926,129 @@ cleanup:
 } /* merge_many_buff */
 
 
+/**
+  Returns how many chunks are merged at a time by filesort.
+
+  Each chunk gets an equal share of the sort buffer for reading ahead
+  in the merge. Merge as many chunks at a time as leaves each of them
+  room for MERGE_READ_MIN_SIZE bytes and one record, but never fewer
+  than MERGEBUFF2, which the sort buffer is always large enough for.
+
+  @param param        Sort parameters.
+  @param buffer_size  Size of the sort buffer used for merging.
+*/
+static uint merge_fanin(const Sort_param *param, size_t buffer_size)
+{
+  const size_t fanin= min<size_t>(buffer_size / MERGE_READ_MIN_SIZE,
+                                  param->max_keys_per_buffer);
+  return static_cast<uint>(max<size_t>(fanin, MERGEBUFF2));
+}
+
+
+/**
+  Merges chunks until no more than 'fanin' chunks are left for the final
+  merge. Every pass over the sort file merges the chunks in groups of at
+  most 'fanin' chunks, spreading them evenly over the fewest groups
+  possible.
+
+  @param param          Sort parameters.
+  @param sort_buffer    The main memory buffer.
+  @param chunk_array    Array of chunk descriptors to merge.
+  @param fanin          Max number of chunks to merge at a time.
+  @param p_num_chunks [out]
+                        output: the number of chunks left in the output file.
+  @param t_file         Where to store the result.
+  @param merge_passes [out]  Number of merge_buffers() calls.
+  @param file_rewrites [out] Number of passes over the sort file.
+*/
+static int merge_chunks_to_fanin(Sort_param *param, Sort_buffer sort_buffer,
+                                 Merge_chunk_array chunk_array, uint fanin,
+                                 size_t *p_num_chunks, IO_CACHE *t_file,
+                                 uint *merge_passes, uint *file_rewrites)
+{
+  IO_CACHE t_file2,*from_file,*to_file,*temp;
+  DBUG_ENTER("merge_chunks_to_fanin");
+
+  size_t num_chunks= chunk_array.size();
+  *p_num_chunks= num_chunks;
+  *merge_passes= 0;
+  *file_rewrites= 0;
+
+  if (num_chunks <= fanin)
+    DBUG_RETURN(0);
+  if (flush_io_cache(t_file) ||
+      open_cached_file(&t_file2,mysql_tmpdir,TEMP_PREFIX,DISK_BUFFER_SIZE,
+                       MYF(MY_WME)))
+    DBUG_RETURN(1);                             /* purecov: inspected */
+
+  from_file= t_file ; to_file= &t_file2;
+  while (num_chunks > fanin)
+  {
+    if (reinit_io_cache(from_file,READ_CACHE,0L,0,0))
+      goto cleanup;
+    if (reinit_io_cache(to_file,WRITE_CACHE,0L,0,0))
+      goto cleanup;
+    const size_t num_merges= (num_chunks + fanin - 1) / fanin;
+    Merge_chunk *last_chunk= chunk_array.begin();
+    size_t first= 0;
+    for (size_t i= 0; i < num_merges; i++)
+    {
+      const size_t last= num_chunks * (i + 1) / num_merges;
+      if (merge_buffers(param,                  // param
+                        from_file,              // from_file
+                        to_file,                // to_file
+                        sort_buffer,            // sort_buffer
+                        last_chunk++,           // last_chunk [out]
+                        Merge_chunk_array(&chunk_array[first],
+                                          last - first),
+                        0))                     // flag
+        goto cleanup;
+      first= last;
+      (*merge_passes)++;
+    }
+    if (flush_io_cache(to_file))
+      goto cleanup;                             /* purecov: inspected */
+    temp=from_file; from_file=to_file; to_file=temp;
+    setup_io_cache(from_file);
+    setup_io_cache(to_file);
+    num_chunks= num_merges;
+    (*file_rewrites)++;
+  }
+cleanup:
+  close_cached_file(to_file);			// This holds old result
+  if (to_file == t_file)
+  {
+    *t_file=t_file2;				// Copy result file
+    setup_io_cache(t_file);
+  }
+
+  *p_num_chunks= num_chunks;
+  DBUG_RETURN(num_chunks > fanin);      /* Return 1 if interrupted */
+} /* merge_chunks_to_fanin */
+
+
+/**
+  Counts the merge_buffers() calls and the passes over the sort file
+  that merge_many_buff() needs before the final merge of num_chunks
+  chunks.
+*/
+static void merge_many_buff_passes(size_t num_chunks, uint *merge_passes,
+                                   uint *file_rewrites)
+{
+  *merge_passes= 0;
+  *file_rewrites= 0;
+  while (num_chunks > MERGEBUFF2)
+  {
+    // The last merge of a pass takes the remaining 1 to 1.5 * MERGEBUFF.
+    const size_t num_merges=
+      1 + (num_chunks - MERGEBUFF * 3 / 2 + MERGEBUFF - 1) / MERGEBUFF;
+    *merge_passes+= num_merges;
+    (*file_rewrites)++;
+    num_chunks= num_merges;
+  }
+}
+
+
 /**
   Read data to buffer.
 
@@ -2094,9 +2247,7 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
     doing_unique ?
     Merge_chunk_less(cmp, first_cmp_arg) :
     Merge_chunk_less(sort_length);
-  Priority_queue<Merge_chunk*,
-                 std::vector<Merge_chunk*, Malloc_allocator<Merge_chunk*> >,
-                 Merge_chunk_less>
+  Loser_tree<Merge_chunk*, Merge_chunk_less, Malloc_allocator<Merge_chunk*> >
     queue(mcl,
           Malloc_allocator<Merge_chunk*>(key_memory_Filesort_info_merge));
 
@@ -2118,6 +2269,7 @@ int merge_buffers(Sort_param *param, IO_CACHE *from_file,
     merge_chunk->set_max_keys(merge_chunk->mem_count());
     (void) queue.push(merge_chunk);
   }
+  queue.build();
 
   if (doing_unique)
   {
@@ -18,12 +18,15 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include "my_thread.h"
+#include "mysql/psi/mysql_thread.h"
 
 #include <algorithm>
 #include <functional>
 #include <vector>
 
 PSI_memory_key key_memory_Filesort_buffer_sort_keys;
+PSI_thread_key key_thread_filesort;
 
 namespace {
 /**
@@ -215,27 +218,21 @@ size_t try_reserve(std::pair<type*, ptrdiff_t> *buf, ptrdiff_t size)
   return buf->second;
 }
 
-} // namespace
+/**
+  Sorts an array of pointers to keys with the algorithm best suited for
+  the number of keys and the key length.
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+  @param keys         the keys to sort
+  @param count        the number of keys
+  @param sort_length  the length of a key, the keys are compared by memcmp()
+*/
+void sort_keys(uchar **keys, uint count, size_t sort_length)
 {
-  m_sort_keys= get_sort_keys();
-
-  if (count <= 1)
-    return;
-  if (param->sort_length == 0)
-    return;
-
-  // For priority queue we have already reversed the pointers.
-  if (!param->using_pq)
-  {
-    reverse_record_pointers();
-  }
   std::pair<uchar**, ptrdiff_t> buffer;
-  if (radixsort_is_appliccable(count, param->sort_length) &&
+  if (radixsort_is_appliccable(count, sort_length) &&
       try_reserve(&buffer, count))
   {
-    radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer.first);
+    radixsort_for_str_ptr(keys, count, sort_length, buffer.first);
     std::return_temporary_buffer(buffer.first);
     return;
   }
@@ -247,23 +244,201 @@ void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
   */
   if (count <= 100)
   {
-    if (param->sort_length < 10)
+    if (sort_length < 10)
     {
-      std::sort(m_sort_keys, m_sort_keys + count,
-                Mem_compare(param->sort_length));
+      std::sort(keys, keys + count, Mem_compare(sort_length));
       return;
     }
-    std::sort(m_sort_keys, m_sort_keys + count,
-              Mem_compare_longkey(param->sort_length));
+    std::sort(keys, keys + count, Mem_compare_longkey(sort_length));
     return;
   }
   // Heuristics here: avoid function overhead call for short keys.
-  if (param->sort_length < 10)
+  if (sort_length < 10)
+  {
+    std::stable_sort(keys, keys + count, Mem_compare(sort_length));
+    return;
+  }
+  std::stable_sort(keys, keys + count, Mem_compare_longkey(sort_length));
+}
+
+
+/**
+  A part of a parallel sort, done by one thread: either sorting a run of
+  keys, or merging two adjacent sorted runs into another array.
+*/
+struct Sort_task
+{
+  uchar **keys;               ///< The run to sort, or the first run to merge
+  uint count;                 ///< Number of keys in 'keys'
+  uint count2;                ///< Number of keys in the second run, if merging
+  uchar **to;                 ///< Where to merge the runs, NULL if sorting
+  size_t sort_length;         ///< Length of the keys
+};
+
+
+void run_sort_task(Sort_task *task)
+{
+  if (task->to == NULL)
+  {
+    sort_keys(task->keys, task->count, task->sort_length);
+    return;
+  }
+  uchar **const mid= task->keys + task->count;
+  uchar **const end= mid + task->count2;
+  if (task->sort_length < 10)
+    std::merge(task->keys, mid, mid, end, task->to,
+               Mem_compare(task->sort_length));
+  else
+    std::merge(task->keys, mid, mid, end, task->to,
+               Mem_compare_longkey(task->sort_length));
+}
+
+
+extern "C" void *sort_task_thread(void *arg)
+{
+  my_thread_init();
+  run_sort_task(static_cast<Sort_task*>(arg));
+  my_thread_end();
+  return NULL;
+}
+
+
+/**
+  Runs sort tasks in parallel, one thread each. The first task is run by
+  the calling thread, and so is any task for which no thread could be
+  started.
+
+  @param tasks  the tasks to run
+  @param count  the number of tasks
+*/
+void run_sort_tasks(Sort_task *tasks, uint count)
+{
+  std::vector<my_thread_handle> threads(count);
+  std::vector<bool> started(count, false);
+
+  for (uint i= 1; i < count; i++)
+  {
+    my_thread_attr_t attr;
+    my_thread_attr_init(&attr);
+    started[i]= mysql_thread_create(key_thread_filesort, &threads[i], &attr,
+                                    sort_task_thread, &tasks[i]) == 0;
+    my_thread_attr_destroy(&attr);
+    if (!started[i])
+      run_sort_task(&tasks[i]);
+  }
+
+  run_sort_task(&tasks[0]);
+
+  for (uint i= 1; i < count; i++)
   {
-    std::stable_sort(m_sort_keys, m_sort_keys + count,
-                     Mem_compare(param->sort_length));
+    if (started[i])
+      my_thread_join(&threads[i], NULL);
+  }
+}
+
+
+/**
+  Sorts an array of pointers to keys with several threads: the array is
+  split into one run per thread, the runs are sorted in parallel and then
+  merged pairwise, the merges of each round also running in parallel.
+  Merging is stable, so the result is the same as with sort_keys().
+
+  @param keys         the keys to sort
+  @param count        the number of keys
+  @param sort_length  the length of a key
+  @param threads      the number of threads to use, at least 2
+
+  @returns false if the keys were sorted, true if the memory for merging
+           could not be allocated.
+*/
+bool sort_keys_parallel(uchar **keys, uint count, size_t sort_length,
+                        uint threads)
+{
+  DBUG_ASSERT(threads > 1);
+  DBUG_ASSERT(count >= threads);
+
+  uchar **const tmp= static_cast<uchar**>(
+    my_malloc(key_memory_Filesort_buffer_sort_keys,
+              count * sizeof(uchar*), MYF(0)));
+  if (tmp == NULL)
+    return true;
+
+  std::vector<uint> runs;
+  for (uint i= 0; i < threads; i++)
+    runs.push_back(static_cast<uint>(static_cast<ulonglong>(count) * i /
+                                     threads));
+  runs.push_back(count);
+
+  std::vector<Sort_task> tasks(threads);
+  for (uint i= 0; i < threads; i++)
+  {
+    Sort_task task= { keys + runs[i], runs[i + 1] - runs[i], 0, NULL,
+                      sort_length };
+    tasks[i]= task;
+  }
+  run_sort_tasks(&tasks[0], threads);
+
+  uchar **from= keys;
+  uchar **to= tmp;
+  while (runs.size() > 2)
+  {
+    std::vector<uint> merged;
+    tasks.clear();
+    for (size_t i= 0; i + 1 < runs.size(); i+= 2)
+    {
+      merged.push_back(runs[i]);
+      if (i + 2 < runs.size())
+      {
+        Sort_task task= { from + runs[i], runs[i + 1] - runs[i],
+                          runs[i + 2] - runs[i + 1], to + runs[i],
+                          sort_length };
+        tasks.push_back(task);
+      }
+      else
+      {
+        // An odd run out, just move it along
+        memcpy(to + runs[i], from + runs[i],
+               (runs[i + 1] - runs[i]) * sizeof(uchar*));
+      }
+    }
+    merged.push_back(count);
+    run_sort_tasks(&tasks[0], static_cast<uint>(tasks.size()));
+    runs.swap(merged);
+    std::swap(from, to);
+  }
+
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+  my_free(tmp);
+  return false;
+}
+
+} // namespace
+
+void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+{
+  m_sort_keys= get_sort_keys();
+
+  if (count <= 1)
+    return;
+  if (param->sort_length == 0)
     return;
+
+  // For priority queue we have already reversed the pointers.
+  if (!param->using_pq)
+  {
+    reverse_record_pointers();
   }
-  std::stable_sort(m_sort_keys, m_sort_keys + count,
-                   Mem_compare_longkey(param->sort_length));
+
+  /*
+    Use at most one thread per MIN_KEYS_PER_SORT_THREAD keys: for smaller
+    runs the cost of starting the threads exceeds what they save.
+  */
+  const uint threads=
+    std::min<uint>(param->sort_threads, count / MIN_KEYS_PER_SORT_THREAD);
+  if (threads > 1 &&
+      !sort_keys_parallel(m_sort_keys, count, param->sort_length, threads))
+    return;
+
+  sort_keys(m_sort_keys, count, param->sort_length);
 }
@@ -626,6 +626,9 @@ public:
   const char *func_name() const { return "<if>"; };
   bool const_item() const { return FALSE; }
   bool *get_trig_var() { return trig_var; }
+  enum_trig_type get_trig_type() const { return trig_type; }
+  /// Index of the table which is the source of trig_var, if any
+  plan_idx idx() const { return m_idx; }
   /* The following is needed for ICP: */
   table_map used_tables() const { return args[0]->used_tables(); }
   void print(String *str, enum_query_type query_type);
@@ -895,11 +895,11 @@ bool Aggregator_distinct::setup(THD *thd)
     if (table->hash_field)
       table->file->ha_index_init(0, 0);
 
-    if (table->s->db_type() == heap_hton)
+    if (table->s->db_type() == heap_hton && !table->s->blob_fields)
     {
       /*
-        No blobs, otherwise it would have been MyISAM: set up a compare
-        function and its arguments to use with Unique.
+        No blobs: set up a compare function and its arguments to use with
+        Unique.
       */
       qsort_cmp2 compare_key;
       void* cmp_arg;
@@ -1123,7 +1123,19 @@ bool Aggregator_distinct::add()
       return false;
     if ((error= table->file->ha_write_row(table->record[0])) &&
         !table->file->is_ignorable_error(error))
-      return TRUE;
+    {
+      /* A MEMORY table with blobs may run out of space */
+      if (create_ondisk_from_heap(table->in_use, table,
+                                  tmp_table_param->start_recinfo,
+                                  &tmp_table_param->recinfo,
+                                  error, TRUE, NULL))
+        return TRUE;
+      if (table->hash_field && (error= table->file->ha_index_init(0, 0)))
+      {
+        table->file->print_error(error, MYF(0));
+        return TRUE;
+      }
+    }
     return FALSE;
   }
   else
@@ -6686,6 +6686,8 @@ SHOW_VAR status_vars[]= {
 #endif
   {"Slow_queries",             (char*) offsetof(STATUS_VAR, long_query_count),         SHOW_LONGLONG_STATUS,   SHOW_SCOPE_ALL},
   {"Sort_merge_passes",        (char*) offsetof(STATUS_VAR, filesort_merge_passes),    SHOW_LONGLONG_STATUS,   SHOW_SCOPE_ALL},
+  {"Sort_merge_saved_bytes",   (char*) offsetof(STATUS_VAR, filesort_merge_saved_bytes), SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
+  {"Sort_merge_saved_passes",  (char*) offsetof(STATUS_VAR, filesort_merge_saved_passes), SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
   {"Sort_range",               (char*) offsetof(STATUS_VAR, filesort_range_count),     SHOW_LONGLONG_STATUS,   SHOW_SCOPE_ALL},
   {"Sort_rows",                (char*) offsetof(STATUS_VAR, filesort_rows),            SHOW_LONGLONG_STATUS,   SHOW_SCOPE_ALL},
   {"Sort_scan",                (char*) offsetof(STATUS_VAR, filesort_scan_count),      SHOW_LONGLONG_STATUS,   SHOW_SCOPE_ALL},
@@ -8606,7 +8608,8 @@ static PSI_thread_info all_server_threads[]=
   { &key_thread_signal_hand, "signal_handler", PSI_FLAG_GLOBAL},
   { &key_thread_compress_gtid_table, "compress_gtid_table", PSI_FLAG_GLOBAL},
   { &key_thread_parser_service, "parser_service", PSI_FLAG_GLOBAL},
-  { &key_thread_background, "background", PSI_FLAG_GLOBAL}
+  { &key_thread_background, "background", PSI_FLAG_GLOBAL},
+  { &key_thread_filesort, "filesort", 0}
 };
 
 PSI_file_key key_file_map;
@@ -8970,6 +8973,7 @@ PSI_memory_key key_memory_TABLE_sort_io_cache;
 PSI_memory_key key_memory_frm;
 PSI_memory_key key_memory_Unique_sort_buffer;
 PSI_memory_key key_memory_Unique_merge_buffer;
+PSI_memory_key key_memory_Group_hash;
 PSI_memory_key key_memory_TABLE;
 PSI_memory_key key_memory_frm_extra_segment_buff;
 PSI_memory_key key_memory_frm_form_pos;
@@ -9116,6 +9120,7 @@ static PSI_memory_info all_server_memory[]=
   { &key_memory_frm, "frm", 0},
   { &key_memory_Unique_sort_buffer, "Unique::sort_buffer", 0},
   { &key_memory_Unique_merge_buffer, "Unique::merge_buffer", 0},
+  { &key_memory_Group_hash, "Group_hash", 0},
   { &key_memory_TABLE, "TABLE", PSI_FLAG_GLOBAL}, /* Table cache */
   { &key_memory_frm_extra_segment_buff, "frm::extra_segment_buff", 0},
   { &key_memory_frm_form_pos, "frm::form_pos", 0},
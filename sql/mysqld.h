@@ -458,6 +458,7 @@ extern PSI_thread_key key_thread_bootstrap,
   key_thread_compress_gtid_table, key_thread_parser_service;
 extern PSI_thread_key key_thread_timer_notifier;
 extern PSI_thread_key key_thread_background;
+extern PSI_thread_key key_thread_filesort;
 
 extern PSI_file_key key_file_map;
 extern PSI_file_key key_file_binlog, key_file_binlog_index, key_file_casetest,
@@ -591,6 +592,7 @@ extern PSI_memory_key key_memory_frm_form_pos;
 extern PSI_memory_key key_memory_frm_string;
 extern PSI_memory_key key_memory_Unique_sort_buffer;
 extern PSI_memory_key key_memory_Unique_merge_buffer;
+extern PSI_memory_key key_memory_Group_hash;
 extern PSI_memory_key key_memory_shared_memory_name;
 extern PSI_memory_key key_memory_opt_bin_logname;
 extern PSI_memory_key key_memory_Query_cache;
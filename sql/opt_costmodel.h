@@ -97,6 +97,26 @@ public:
     return keys * m_server_cost_constants->key_compare_cost();
   }
 
+  /**
+    Cost of a hash join: every record of the build input is hashed and
+    inserted into the hash table, and every record of the probe input is
+    hashed and looked up in it.
+
+    @param build_rows number of records inserted into the hash table
+    @param probe_rows number of records looked up in the hash table
+
+    @return Cost of building and probing the hash table
+  */
+
+  double hash_join_cost(double build_rows, double probe_rows) const
+  {
+    DBUG_ASSERT(m_initialized);
+    DBUG_ASSERT(build_rows >= 0.0);
+    DBUG_ASSERT(probe_rows >= 0.0);
+
+    return key_compare_cost(build_rows + probe_rows);
+  }
+
 private:
   /**
     Cost of creating a temporary table in the memory storage engine.
@@ -1666,6 +1666,8 @@ bool Explain_join::explain_extra()
       StringBuffer<64> buff(cs);
       if (t == JOIN_CACHE::ALG_BNL)
         buff.append("Block Nested Loop");
+      else if (t == JOIN_CACHE::ALG_BNL_HASH)
+        buff.append("Hash Join");
         else if (t == JOIN_CACHE::ALG_BKA)
         buff.append("Batched Key Access");
       else if (t == JOIN_CACHE::ALG_BKA_UNIQUE)
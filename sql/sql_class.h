@@ -470,6 +470,7 @@ typedef struct system_variables
   ulong read_rnd_buff_size;
   ulong div_precincrement;
   ulong sortbuff_size;
+  ulong sort_threads;
   ulong max_sp_recursion_depth;
   ulong default_week_format;
   ulong max_seeks_for_key;
@@ -611,6 +612,8 @@ typedef struct system_status_var
   ulonglong select_scan_count;
   ulonglong long_query_count;
   ulonglong filesort_merge_passes;
+  ulonglong filesort_merge_saved_bytes;
+  ulonglong filesort_merge_saved_passes;
   ulonglong filesort_range_count;
   ulonglong filesort_rows;
   ulonglong filesort_scan_count;
@@ -80,6 +80,8 @@
 
 #define DEFAULT_SORT_MEMORY (256UL* 1024UL)
 #define MIN_SORT_MEMORY     (32UL * 1024UL)
+/* Filesort uses one thread per this many keys at most, see sort_threads */
+#define MIN_KEYS_PER_SORT_THREAD 10000
 
 /* Some portable defines */
 
@@ -295,7 +297,8 @@
 #define OPTIMIZER_SWITCH_USE_INDEX_EXTENSIONS      (1ULL << 16)
 #define OPTIMIZER_SWITCH_COND_FANOUT_FILTER        (1ULL << 17)
 #define OPTIMIZER_SWITCH_DERIVED_MERGE             (1ULL << 18)
-#define OPTIMIZER_SWITCH_LAST                      (1ULL << 19)
+#define OPTIMIZER_SWITCH_HASH_JOIN                 (1ULL << 19)
+#define OPTIMIZER_SWITCH_LAST                      (1ULL << 20)
 
 #define OPTIMIZER_SWITCH_DEFAULT (OPTIMIZER_SWITCH_INDEX_MERGE | \
                                   OPTIMIZER_SWITCH_INDEX_MERGE_UNION | \
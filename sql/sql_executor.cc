@@ -3395,20 +3395,82 @@ end:
 }
 
 
+/**
+  Write the groups collected in memory to the GROUP BY temporary table,
+  and stop collecting groups in memory.
+
+  @param join     the join
+  @param qep_tab  the temporary table
+
+  @return true if error
+*/
+
+static bool write_hashed_groups(JOIN *join, QEP_TAB *const qep_tab)
+{
+  TABLE *const table= qep_tab->table();
+  Temp_table_param *const tmp_tbl= qep_tab->tmp_table_param;
+  Group_hash *const group_hash=
+    &static_cast<QEP_tmp_table *>(qep_tab->op)->group_hash;
+  const size_t reclength= table->s->reclength;
+  bool res= false;
+  int error;
+  DBUG_ENTER("write_hashed_groups");
+
+  // record[0] may hold a new group, which is written after the others
+  memcpy(group_hash->saved_record(), table->record[0], reclength);
+  for (Group_hash::Group *group= group_hash->first_group();
+       group != NULL && !res;
+       group= group->next)
+  {
+    memcpy(table->record[0], group_hash->group_record(group), reclength);
+    if ((error= table->file->ha_write_row(table->record[0])))
+    {
+      if (create_ondisk_from_heap(join->thd, table,
+                                  tmp_tbl->start_recinfo,
+                                  &tmp_tbl->recinfo,
+                                  error, FALSE, NULL))
+        res= true;                              // Not a table_is_full error
+      else if ((error= table->file->ha_index_init(0, 0)))
+      {
+        table->file->print_error(error, MYF(0));
+        res= true;
+      }
+    }
+  }
+  memcpy(table->record[0], group_hash->saved_record(), reclength);
+  group_hash->end();
+  DBUG_RETURN(res);
+}
+
+
 /* ARGSUSED */
-/** Group by searching after group record and updating it if possible. */
+/**
+  Group by searching after group record and updating it if possible.
+
+  While the groups fit in memory, they are collected in the Group_hash
+  of the table, and written to the table at the end. Once they do not,
+  all groups are written to the table, which is used for the remaining
+  records.
+*/
 
 static enum_nested_loop_state
 end_update(JOIN *join, QEP_TAB *const qep_tab, bool end_of_records)
 {
   TABLE *const table= qep_tab->table();
+  Group_hash *const group_hash=
+    &static_cast<QEP_tmp_table *>(qep_tab->op)->group_hash;
   ORDER *group;
   int error;
   bool group_found= false;
+  uint32 hash_value= 0;
   DBUG_ENTER("end_update");
 
   if (end_of_records)
+  {
+    if (group_hash->is_active() && write_hashed_groups(join, qep_tab))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
     DBUG_RETURN(NESTED_LOOP_OK);
+  }
   if (join->thd->killed)			// Aborted by user
   {
     join->thd->send_kill_message();
@@ -3446,10 +3508,23 @@ end_update(JOIN *join, QEP_TAB *const qep_tab, bool end_of_records)
         group->buff[-1]= (char) group->field->is_null();
     }
     const uchar *key= tmp_tbl->group_buff;
-    if (!table->file->ha_index_read_map(table->record[1],
-                                        key,
-                                        HA_WHOLE_KEY,
-                                        HA_READ_KEY_EXACT))
+    if (group_hash->is_active())
+    {
+      hash_value= group_hash->hash_key(key);
+      uchar *const record= group_hash->find(key, hash_value);
+      if (record != NULL)
+      {
+        /* Update the group record in memory */
+        memcpy(table->record[0], record, table->s->reclength);
+        update_tmptable_sum_func(join->sum_funcs, table);
+        memcpy(record, table->record[0], table->s->reclength);
+        DBUG_RETURN(NESTED_LOOP_OK);
+      }
+    }
+    else if (!table->file->ha_index_read_map(table->record[1],
+                                             key,
+                                             HA_WHOLE_KEY,
+                                             HA_READ_KEY_EXACT))
       group_found= true;
   }
   if (group_found)
@@ -3463,8 +3538,31 @@ end_update(JOIN *join, QEP_TAB *const qep_tab, bool end_of_records)
       // Old and new records are the same, ok to ignore
       if (error == HA_ERR_RECORD_IS_THE_SAME)
         DBUG_RETURN(NESTED_LOOP_OK);
-      table->file->print_error(error, MYF(0));   /* purecov: inspected */
-      DBUG_RETURN(NESTED_LOOP_ERROR);            /* purecov: inspected */
+      if (error != HA_ERR_RECORD_FILE_FULL)
+      {
+        table->file->print_error(error, MYF(0)); /* purecov: inspected */
+        DBUG_RETURN(NESTED_LOOP_ERROR);          /* purecov: inspected */
+      }
+      /*
+        A packed group record grew past the size of the MEMORY table.
+        Redo the update as a delete and an insert of the new record,
+        which create_ondisk_from_heap() writes to the on-disk table.
+      */
+      if ((error= table->file->ha_delete_row(table->record[1])))
+      {
+        table->file->print_error(error, MYF(0));
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+      }
+      if (create_ondisk_from_heap(join->thd, table,
+                                  tmp_tbl->start_recinfo,
+                                  &tmp_tbl->recinfo,
+                                  HA_ERR_RECORD_FILE_FULL, FALSE, NULL))
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+      if ((error= table->file->ha_index_init(0, 0)))
+      {
+        table->file->print_error(error, MYF(0));
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+      }
     }
     DBUG_RETURN(NESTED_LOOP_OK);
   }
@@ -3489,6 +3587,18 @@ end_update(JOIN *join, QEP_TAB *const qep_tab, bool end_of_records)
       DBUG_RETURN(NESTED_LOOP_ERROR);           /* purecov: inspected */
   }
   init_tmptable_sum_functions(join->sum_funcs);
+  if (group_hash->is_active())
+  {
+    if (!group_hash->insert(tmp_tbl->group_buff, hash_value,
+                            table->record[0]))
+    {
+      qep_tab->send_records++;
+      DBUG_RETURN(NESTED_LOOP_OK);
+    }
+    /* Out of memory for groups: continue grouping in the table */
+    if (write_hashed_groups(join, qep_tab))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+  }
   if ((error=table->file->ha_write_row(table->record[0])))
   {
     if (create_ondisk_from_heap(join->thd, table,
@@ -3769,8 +3879,8 @@ QEP_TAB::remove_duplicates()
 
   free_io_cache(tbl);				// Safety
   tbl->file->info(HA_STATUS_VARIABLE);
-  if (tbl->s->db_type() == heap_hton ||
-      (!tbl->s->blob_fields &&
+  if (!tbl->s->blob_fields &&
+      (tbl->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(reclength) + HASH_OVERHEAD) * tbl->file->stats.records <
 	join()->thd->variables.sortbuff_size)))
     error=remove_dup_with_hash_index(join()->thd, tbl,
@@ -4574,6 +4684,286 @@ static void restore_const_null_info(JOIN *join, table_map save_nullinfo)
 }
 
 
+/****************************************************************************
+  Group_hash implementation
+****************************************************************************/
+
+/// Number of buckets of a new Group_hash.
+static const size_t GROUP_HASH_MIN_BUCKETS= 1024;
+
+Group_hash::Group_hash()
+  : m_table(NULL), m_key_info(NULL),
+    m_key_offset(0), m_record_offset(0), m_group_size(0),
+    m_buckets(NULL), m_num_buckets(0), m_num_groups(0),
+    m_first(NULL), m_last(NULL), m_saved_record(NULL),
+    m_memory_used(0), m_max_memory(0)
+{
+  init_sql_alloc(key_memory_Group_hash, &m_mem_root, 8192, 0);
+}
+
+
+/**
+  Check whether the groups of a temporary table can be collected in a
+  Group_hash.
+
+  The group key must be stored in index format, i.e. not as a hash
+  field, and must not contain approximate numbers, for which equal
+  values may have different key images. Records with blobs are not
+  supported, as the blob data is not part of the record.
+
+  @param table  the GROUP BY temporary table
+
+  @return true if the table can use a Group_hash
+*/
+
+bool Group_hash::is_usable(const TABLE *table)
+{
+  if (!table->group || table->hash_field || !table->s->keys ||
+      table->s->blob_fields)
+    return false;
+
+  const KEY *const key_info= table->key_info;
+  for (uint i= 0; i < key_info->user_defined_key_parts; i++)
+  {
+    switch (key_info->key_part[i].type)
+    {
+    case HA_KEYTYPE_FLOAT:
+    case HA_KEYTYPE_DOUBLE:
+    case HA_KEYTYPE_NUM:
+      return false;
+    default:
+      break;
+    }
+  }
+  return true;
+}
+
+
+/**
+  Start collecting groups for a temporary table.
+
+  @param table       the GROUP BY temporary table
+  @param max_memory  the memory limit, after which insert() fails
+
+  @return true if out of memory
+*/
+
+bool Group_hash::init(TABLE *table, size_t max_memory)
+{
+  DBUG_ASSERT(is_usable(table));
+  end();
+
+  m_key_info= table->key_info;
+  m_key_offset= ALIGN_SIZE(sizeof(Group));
+  m_record_offset= ALIGN_SIZE(m_key_offset + m_key_info->key_length);
+  m_group_size= m_record_offset + table->s->reclength;
+  m_max_memory= max_memory;
+
+  if (m_buckets == NULL)
+  {
+    if (!(m_buckets= (Group**) my_malloc(key_memory_Group_hash,
+                                         GROUP_HASH_MIN_BUCKETS *
+                                         sizeof(Group*), MYF(MY_WME))))
+      return true;
+    m_num_buckets= GROUP_HASH_MIN_BUCKETS;
+  }
+  memset(m_buckets, 0, m_num_buckets * sizeof(Group*));
+
+  if (!(m_saved_record= (uchar*) alloc_root(&m_mem_root,
+                                            table->s->reclength)))
+    return true;
+  m_memory_used= m_num_buckets * sizeof(Group*) + table->s->reclength;
+  m_table= table;
+  return false;
+}
+
+
+/**
+  Stop collecting groups. The memory of the groups is kept for the
+  next execution, except for a bucket array that has grown.
+*/
+
+void Group_hash::end()
+{
+  m_table= NULL;
+  m_first= m_last= NULL;
+  m_num_groups= 0;
+  m_memory_used= 0;
+  m_saved_record= NULL;
+  free_root(&m_mem_root, MYF(MY_MARK_BLOCKS_FREE));
+  if (m_num_buckets > GROUP_HASH_MIN_BUCKETS)
+  {
+    my_free(m_buckets);
+    m_buckets= NULL;
+    m_num_buckets= 0;
+  }
+}
+
+
+/// Release all memory.
+
+void Group_hash::free()
+{
+  end();
+  free_root(&m_mem_root, MYF(0));
+  my_free(m_buckets);
+  m_buckets= NULL;
+  m_num_buckets= 0;
+}
+
+
+/**
+  Compute the hash value of a group key.
+
+  Keys which compare as equal with key_cmp2() get the same hash value:
+  character strings are hashed with their collation, and a NULL key
+  part contributes only its NULL flag.
+
+  @param key  the group key, in the format of TABLE::key_info[0]
+
+  @return the hash value
+*/
+
+uint32 Group_hash::hash_key(const uchar *key) const
+{
+  ulong nr1= 1, nr2= 4;
+  const KEY_PART_INFO *key_part= m_key_info->key_part;
+  const KEY_PART_INFO *const key_part_end=
+    key_part + m_key_info->user_defined_key_parts;
+
+  for (; key_part < key_part_end; key+= key_part->store_length, key_part++)
+  {
+    const uchar *pos= key;
+    size_t length= key_part->length;
+    if (key_part->null_bit)
+    {
+      if (*pos)
+      {
+        nr1^= (nr1 << 1) | 1;
+        continue;
+      }
+      pos++;
+    }
+    if (key_part->key_part_flag & HA_VAR_LENGTH_PART)
+    {
+      length= uint2korr(pos);
+      pos+= HA_KEY_BLOB_LENGTH;
+    }
+    const CHARSET_INFO *cs= &my_charset_bin;
+    if (key_part->type == HA_KEYTYPE_TEXT ||
+        key_part->type == HA_KEYTYPE_VARTEXT1 ||
+        key_part->type == HA_KEYTYPE_VARTEXT2)
+      cs= key_part->field->charset();
+    cs->coll->hash_sort(cs, pos, length, &nr1, &nr2);
+  }
+  return static_cast<uint32>(nr1);
+}
+
+
+/**
+  Look up a group.
+
+  @param key   the group key
+  @param hash  hash_key() of the group key
+
+  @return the record of the group, or NULL if there is no such group
+*/
+
+uchar *Group_hash::find(const uchar *key, uint32 hash) const
+{
+  const size_t mask= m_num_buckets - 1;
+  for (size_t i= hash & mask; m_buckets[i] != NULL; i= (i + 1) & mask)
+  {
+    Group *const group= m_buckets[i];
+    if (group->hash == hash &&
+        !key_cmp2(m_key_info->key_part,
+                  key, m_key_info->key_length,
+                  group_key(group), m_key_info->key_length))
+      return group_record(group);
+  }
+  return NULL;
+}
+
+
+/**
+  Add a new group, after the groups inserted before.
+
+  @param key     the group key, which must not be in the hash yet
+  @param hash    hash_key() of the group key
+  @param record  the initial record of the group
+
+  @return true if the memory limit was reached, or out of memory
+*/
+
+bool Group_hash::insert(const uchar *key, uint32 hash, const uchar *record)
+{
+  DBUG_ASSERT(is_active());
+  if (m_memory_used + m_group_size > m_max_memory)
+    return true;
+  if ((m_num_groups + 1) * 2 > m_num_buckets && grow())
+    return true;
+
+  Group *const group= (Group*) alloc_root(&m_mem_root, m_group_size);
+  if (group == NULL)
+    return true;
+  group->next= NULL;
+  group->hash= hash;
+  memcpy(group_key(group), key, m_key_info->key_length);
+  memcpy(group_record(group), record, m_table->s->reclength);
+
+  if (m_last != NULL)
+    m_last->next= group;
+  else
+    m_first= group;
+  m_last= group;
+
+  const size_t mask= m_num_buckets - 1;
+  size_t i= hash & mask;
+  while (m_buckets[i] != NULL)
+    i= (i + 1) & mask;
+  m_buckets[i]= group;
+
+  m_num_groups++;
+  m_memory_used+= m_group_size;
+  return false;
+}
+
+
+/**
+  Double the number of buckets and rehash all groups.
+
+  @return true if the memory limit was reached, or out of memory
+*/
+
+bool Group_hash::grow()
+{
+  const size_t num_buckets= m_num_buckets * 2;
+  const size_t extra_memory= (num_buckets - m_num_buckets) * sizeof(Group*);
+  if (m_memory_used + extra_memory > m_max_memory)
+    return true;
+
+  Group **const buckets=
+    (Group**) my_malloc(key_memory_Group_hash,
+                        num_buckets * sizeof(Group*), MYF(MY_ZEROFILL));
+  if (buckets == NULL)
+    return true;
+
+  const size_t mask= num_buckets - 1;
+  for (Group *group= m_first; group != NULL; group= group->next)
+  {
+    size_t i= group->hash & mask;
+    while (buckets[i] != NULL)
+      i= (i + 1) & mask;
+    buckets[i]= group;
+  }
+  my_free(m_buckets);
+  m_buckets= buckets;
+  m_num_buckets= num_buckets;
+  m_memory_used+= extra_memory;
+  return false;
+}
+
+
 /****************************************************************************
   QEP_tmp_table implementation
 ****************************************************************************/
@@ -4624,6 +5014,16 @@ QEP_tmp_table::prepare_tmp_table()
     table->file->print_error(rc, MYF(0));
     return true;
   }
+  /* Collect the groups in memory first, if possible. */
+  if (write_func == end_update && Group_hash::is_usable(table))
+  {
+    const THD *const thd= join->thd;
+    const ulonglong max_memory=
+      min(thd->variables.tmp_table_size,
+          thd->variables.max_heap_table_size);
+    if (group_hash.init(table, static_cast<size_t>(max_memory)))
+      return true;
+  }
   return false;
 }
 
@@ -217,6 +217,77 @@ public:
 };
 
 
+/**
+  Hash table for grouping rows in memory before they are written to a
+  GROUP BY temporary table.
+
+  Without it, end_update() looks up the group of every row in the index
+  of the temporary table and updates the group record through the
+  handler. When the group key can be hashed (see is_usable()), the group
+  records are instead kept here and written to the temporary table once
+  all rows have been grouped. If they outgrow the memory allowed for an
+  in-memory temporary table, they are written out early and the rest of
+  the rows are grouped in the temporary table as before.
+
+  The hash table uses open addressing with linear probing over the group
+  keys in index format, as built in Temp_table_param::group_buff. Group
+  records, which hold the values of the aggregate functions, are
+  allocated from a MEM_ROOT and chained in insertion order, so groups
+  reach the temporary table in the same order as without the hash table.
+*/
+
+class Group_hash
+{
+public:
+  /// Header of a group, followed by the group key and the group record.
+  struct Group
+  {
+    Group *next;                        ///< Next group in insertion order
+    uint32 hash;                        ///< Hash value of the group key
+  };
+
+  Group_hash();
+  ~Group_hash() { free(); }
+
+  static bool is_usable(const TABLE *table);
+
+  bool init(TABLE *table, size_t max_memory);
+  void end();
+  void free();
+
+  /// True between init() and end().
+  bool is_active() const { return m_table != NULL; }
+
+  uint32 hash_key(const uchar *key) const;
+  uchar *find(const uchar *key, uint32 hash) const;
+  bool insert(const uchar *key, uint32 hash, const uchar *record);
+
+  /// The first group in insertion order, or NULL.
+  Group *first_group() const { return m_first; }
+  /// The record of a group, in the format of TABLE::record[0].
+  uchar *group_record(Group *group) const
+  { return reinterpret_cast<uchar*>(group) + m_record_offset; }
+  /// A spare record buffer, for saving TABLE::record[0].
+  uchar *saved_record() const { return m_saved_record; }
+
+private:
+  bool grow();
+  uchar *group_key(Group *group) const
+  { return reinterpret_cast<uchar*>(group) + m_key_offset; }
+
+  TABLE *m_table;
+  const KEY *m_key_info;                ///< The group key of m_table
+  uint m_key_offset, m_record_offset, m_group_size;
+  MEM_ROOT m_mem_root;                  ///< Groups and the spare record
+  Group **m_buckets;
+  size_t m_num_buckets;                 ///< Always a power of two
+  size_t m_num_groups;
+  Group *m_first, *m_last;
+  uchar *m_saved_record;
+  size_t m_memory_used, m_max_memory;
+};
+
+
 /**
   @brief
     Class for accumulating join result in a tmp table, grouping them if
@@ -230,7 +301,8 @@ public:
                          records are expected to be sorted.
       end_update         Perform grouping using the key generated on tmp
                          table. Input records aren't expected to be sorted.
-                         Tmp table uses the heap engine
+                         Tmp table uses the heap engine. Groups are
+                         collected in group_hash first when possible.
       end_update_unique  Same as above, but the engine is myisam.
 
     Lazy table initialization is used - the table will be instantiated and
@@ -259,6 +331,10 @@ public:
   {
     write_func= new_write_func;
   }
+  void mem_free() { group_hash.free(); }
+
+  /** Groups rows in memory for end_update(), when active. */
+  Group_hash group_hash;
 
 private:
   /** Write function that would be used for saving records in tmp table. */
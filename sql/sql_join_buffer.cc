@@ -2024,6 +2024,527 @@ enum_nested_loop_state JOIN_CACHE_BNL::join_matching_records(bool skip_last)
 }
 
 
+/*
+  Check whether two fields can be compared through their hash values
+
+  SYNOPSIS
+    fields_are_hashable()
+      f1   a field of the joined table
+      f2   a field of one of the buffered tables
+
+  DESCRIPTION
+    The function checks whether the equality f1=f2 holds only if the values
+    of the fields produce the same hash value in key_hash(). This is true
+    for integer and decimal fields, for temporal fields of the same type and
+    precision, and for string fields with the same collation. Equalities of
+    other types either may be true for different representations of the
+    values (as comparisons between approximate numbers or between values of
+    different types) or compare the values in a way that key_hash() does not
+    follow (as JSON values or geometries).
+
+  RETURN
+    TRUE    the equality can be used as a part of the hash join key
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNL_HASH::fields_are_hashable(const Field *f1, const Field *f2)
+{
+  const Field *fields[]= { f1, f2 };
+  for (uint i= 0; i < 2; i++)
+  {
+    switch (fields[i]->real_type()) {
+    case MYSQL_TYPE_FLOAT:
+    case MYSQL_TYPE_DOUBLE:
+    case MYSQL_TYPE_DECIMAL:
+    case MYSQL_TYPE_BIT:
+    case MYSQL_TYPE_ENUM:
+    case MYSQL_TYPE_SET:
+    case MYSQL_TYPE_JSON:
+    case MYSQL_TYPE_GEOMETRY:
+      return false;
+    default:
+      break;
+    }
+  }
+
+  if (f1->result_type() != f2->result_type())
+    return false;
+
+  switch (f1->result_type()) {
+  case INT_RESULT:
+  case DECIMAL_RESULT:
+    return true;
+  case STRING_RESULT:
+    if (f1->is_temporal() || f2->is_temporal())
+      return f1->real_type() == f2->real_type() &&
+             f1->decimals() == f2->decimals();
+    return f1->charset() == f2->charset();
+  default:
+    return false;
+  }
+}
+
+
+/*
+  Check whether a predicate is an equality usable by a hash join
+
+  SYNOPSIS
+    is_key_equality()
+      item         the predicate
+      inner_map    the table to be joined
+      outer_map    the tables whose records are in the join buffer
+      inner_field  OUT the field of the joined table
+      outer_field  OUT the field of one of the buffered tables
+
+  DESCRIPTION
+    The function accepts an equality between two columns or a multiple
+    equality without a constant, if one of the columns belongs to the
+    joined table and another one to one of the buffered tables, and the
+    columns can be compared through their hash values.
+
+  RETURN
+    TRUE    the predicate can be used as a part of the hash join key
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNL_HASH::is_key_equality(Item *item, table_map inner_map,
+                                          table_map outer_map,
+                                          Field **inner_field,
+                                          Field **outer_field)
+{
+  if (item->type() != Item::FUNC_ITEM)
+    return false;
+
+  Item_func *const func= static_cast<Item_func *>(item);
+
+  if (func->functype() == Item_func::EQ_FUNC)
+  {
+    Item *const arg0= func->arguments()[0]->real_item();
+    Item *const arg1= func->arguments()[1]->real_item();
+    if (arg0->type() != Item::FIELD_ITEM || arg1->type() != Item::FIELD_ITEM)
+      return false;
+
+    Item_field *inner= static_cast<Item_field *>(arg0);
+    Item_field *outer= static_cast<Item_field *>(arg1);
+    if (inner->used_tables() != inner_map)
+      std::swap(inner, outer);
+    if (inner->used_tables() != inner_map ||
+        !outer->used_tables() ||
+        (outer->used_tables() & ~outer_map) ||
+        !fields_are_hashable(inner->field, outer->field))
+      return false;
+
+    *inner_field= inner->field;
+    *outer_field= outer->field;
+    return true;
+  }
+
+  if (func->functype() == Item_func::MULT_EQUAL_FUNC)
+  {
+    Item_equal *const item_equal= static_cast<Item_equal *>(func);
+    if (item_equal->get_const())
+      return false;
+
+    Item_equal_iterator inner_it(*item_equal);
+    Item_field *inner;
+    while ((inner= inner_it++))
+    {
+      if (inner->used_tables() != inner_map)
+        continue;
+      Item_equal_iterator outer_it(*item_equal);
+      Item_field *outer;
+      while ((outer= outer_it++))
+      {
+        if ((outer->used_tables() & outer_map) &&
+            fields_are_hashable(inner->field, outer->field))
+        {
+          *inner_field= inner->field;
+          *outer_field= outer->field;
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+
+/*
+  Find the equalities of a condition usable as the hash join key
+
+  SYNOPSIS
+    find_keys()
+      cond          the condition attached to the joined table
+      idx           the position of the joined table in the plan
+      inner_map     the table to be joined
+      outer_map     the tables whose records are in the join buffer
+      inner_fields  OUT the fields of the joined table, may be NULL
+      outer_fields  OUT the fields of the buffered tables, may be NULL
+      n_keys        the number of the key parts found so far
+
+  DESCRIPTION
+    The function looks for key equalities among the conjuncts of 'cond'.
+    A join condition of an outer join is wrapped in a trigger that is
+    switched off only for NULL-complemented records of the joined table,
+    that is, never while matches are looked for: equalities under such a
+    trigger are used too if it is attached to the joined table itself.
+    At most MAX_REF_PARTS key parts are collected.
+
+  RETURN
+    the number of the key parts found
+*/
+
+uint JOIN_CACHE_BNL_HASH::find_keys(Item *cond, plan_idx idx,
+                                    table_map inner_map, table_map outer_map,
+                                    Field **inner_fields,
+                                    Field **outer_fields, uint n_keys)
+{
+  if (cond == NULL || n_keys == MAX_REF_PARTS)
+    return n_keys;
+
+  if (cond->type() == Item::COND_ITEM)
+  {
+    if (static_cast<Item_cond *>(cond)->functype() !=
+        Item_func::COND_AND_FUNC)
+      return n_keys;
+    List_iterator<Item> li(*static_cast<Item_cond *>(cond)->argument_list());
+    Item *item;
+    while ((item= li++))
+      n_keys= find_keys(item, idx, inner_map, outer_map,
+                        inner_fields, outer_fields, n_keys);
+    return n_keys;
+  }
+
+  if (cond->type() == Item::FUNC_ITEM &&
+      static_cast<Item_func *>(cond)->functype() ==
+      Item_func::TRIG_COND_FUNC)
+  {
+    Item_func_trig_cond *const trig= static_cast<Item_func_trig_cond *>(cond);
+    if (trig->get_trig_type() != Item_func_trig_cond::IS_NOT_NULL_COMPL ||
+        trig->idx() != idx)
+      return n_keys;
+    return find_keys(trig->arguments()[0], idx, inner_map, outer_map,
+                     inner_fields, outer_fields, n_keys);
+  }
+
+  Field *inner_field, *outer_field;
+  if (!is_key_equality(cond, inner_map, outer_map, &inner_field, &outer_field))
+    return n_keys;
+
+  if (inner_fields)
+  {
+    inner_fields[n_keys]= inner_field;
+    outer_fields[n_keys]= outer_field;
+  }
+  return n_keys + 1;
+}
+
+
+/*
+  Compute the hash value of a join key
+
+  SYNOPSIS
+    key_hash()
+      fields  the fields of the key
+      n       the number of the fields
+      hash    OUT the hash value
+
+  DESCRIPTION
+    The function computes the hash value of the key made of the current
+    values of 'fields' in the record buffers. Fields for which
+    fields_are_hashable() returns TRUE produce the same hash value for equal
+    values: integers are hashed by value, decimals by their value converted
+    to double, temporal values by their packed representation and strings
+    by the hash function of their collation.
+
+  RETURN
+    TRUE    if the key contains a NULL value and cannot match anything
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNL_HASH::key_hash(Field **fields, uint n, uint32 *hash)
+{
+  ulong nr1= 1, nr2= 4;
+  for (uint i= 0; i < n; i++)
+  {
+    Field *const field= fields[i];
+    if (field->is_null())
+      return true;
+
+    switch (field->result_type()) {
+    case INT_RESULT:
+    {
+      uchar buf[8];
+      int8store(buf, field->val_int());
+      my_charset_bin.coll->hash_sort(&my_charset_bin, buf, sizeof(buf),
+                                     &nr1, &nr2);
+      break;
+    }
+    case DECIMAL_RESULT:
+    {
+      my_decimal value;
+      double nr;
+      my_decimal2double(E_DEC_FATAL_ERROR, field->val_decimal(&value), &nr);
+      if (nr == 0.0)
+        nr= 0.0;                                // Don't distinguish -0.0
+      uchar buf[8];
+      float8store(buf, nr);
+      my_charset_bin.coll->hash_sort(&my_charset_bin, buf, sizeof(buf),
+                                     &nr1, &nr2);
+      break;
+    }
+    default:
+      if (field->is_temporal())
+        my_charset_bin.coll->hash_sort(&my_charset_bin, field->ptr,
+                                       field->pack_length(), &nr1, &nr2);
+      else
+      {
+        char buff[STRING_BUFFER_USUAL_SIZE];
+        String tmp(buff, sizeof(buff), field->charset());
+        const String *str= field->val_str(&tmp);
+        const CHARSET_INFO *cs= field->charset();
+        cs->coll->hash_sort(cs, (const uchar *) str->ptr(),
+                            str->length(), &nr1, &nr2);
+      }
+    }
+  }
+  *hash= static_cast<uint32>(nr1);
+  return false;
+}
+
+
+/* 
+  Initialize a hash join cache
+
+  SYNOPSIS
+    init()
+
+  DESCRIPTION
+    The function initializes the cache as a BNL cache and collects the
+    fields of the join key from the condition attached to the joined
+    table. If no key equality is found the cache works as a BNL cache.
+
+  RETURN
+    0   initialization with buffer allocations has been succeeded
+    1   otherwise
+*/
+
+int JOIN_CACHE_BNL_HASH::init()
+{
+  DBUG_ENTER("JOIN_CACHE_BNL_HASH::init");
+
+  if (JOIN_CACHE_BNL::init())
+    DBUG_RETURN(1);
+
+  uchar *const end= buff + buff_size;
+  hash_entries= reinterpret_cast<Hash_entry *>(
+    end - reinterpret_cast<size_t>(end) % sizeof(ulong));
+
+  inner_fields= (Field **) sql_alloc(2 * MAX_REF_PARTS * sizeof(Field *));
+  if (!inner_fields)
+    DBUG_RETURN(1);
+  outer_fields= inner_fields + MAX_REF_PARTS;
+
+  table_map outer_map= 0;
+  for (uint i= 1; i <= tables; i++)
+    outer_map|= qep_tab[-(int) i].table_ref->map();
+  for (JOIN_CACHE *cache= prev_cache; cache; cache= cache->prev_cache)
+  {
+    for (uint i= 1; i <= cache->tables; i++)
+      outer_map|= cache->qep_tab[-(int) i].table_ref->map();
+  }
+
+  key_parts= find_keys(qep_tab->condition(), qep_tab->idx(),
+                       qep_tab->table_ref->map(), outer_map,
+                       inner_fields, outer_fields, 0);
+
+  Opt_trace_object(&join->thd->opt_trace).
+    add("hash_join_key_parts", key_parts);
+
+  DBUG_RETURN(0);
+}
+
+
+void JOIN_CACHE_BNL_HASH::reset_cache(bool for_writing)
+{
+  JOIN_CACHE_BNL::reset_cache(for_writing);
+  if (for_writing)
+    hashed_records= 0;
+}
+
+
+/* 
+  Add a record into the hash join buffer
+
+  SYNOPSIS
+    put_record_in_cache()
+
+  DESCRIPTION
+    The function writes the record into the join buffer as a BNL cache does
+    and, unless the join key of the record contains a NULL value, adds an
+    entry with the hash value of the key to the hash table.
+
+  RETURN
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNL_HASH::put_record_in_cache()
+{
+  const bool is_full= JOIN_CACHE_BNL::put_record_in_cache();
+  uint32 hash;
+  if (key_parts && !key_hash(outer_fields, key_parts, &hash))
+  {
+    Hash_entry *const entry= hash_entries - ++hashed_records;
+    entry->rec_offset= (ulong) (last_rec_pos - buff);
+    entry->hash= hash;
+    entry->next= 0;
+  }
+  return is_full;
+}
+
+
+/* 
+  Link the entries of the hash table into chains
+
+  SYNOPSIS
+    build_hash_table()
+
+  DESCRIPTION
+    The function places the array of chain heads, one per entry, right
+    before the entries and links each entry into the chain of its hash
+    value. The space for the array has been reserved by rem_space(). The
+    entries of a chain are linked in the order the records were put into
+    the buffer.
+
+  RETURN
+    the array of the chain heads
+*/
+
+uint32 *JOIN_CACHE_BNL_HASH::build_hash_table()
+{
+  uint32 *const buckets=
+    reinterpret_cast<uint32 *>(hash_entries - hashed_records) -
+    hashed_records;
+  DBUG_ASSERT(reinterpret_cast<uchar *>(buckets) >= end_pos);
+
+  memset(buckets, 0, hashed_records * sizeof(uint32));
+  for (uint32 i= hashed_records; i > 0; i--)
+  {
+    Hash_entry *const entry= hash_entries - i;
+    uint32 *const bucket= buckets + entry->hash % hashed_records;
+    entry->next= *bucket;
+    *bucket= i;
+  }
+  return buckets;
+}
+
+
+/*
+  Join records from the join buffer with records from the next join table
+  using the hash table
+
+  SYNOPSIS
+    join_matching_records()
+      skip_last    not used (must be false)
+
+  DESCRIPTION
+    The function scans the joined table once. Each of its records that
+    satisfies the conditions depending only on the table is hashed by its
+    join key, and only the buffered records in the hash chain of this value
+    are read back into the record buffers and checked for a match by
+    generate_full_extensions().
+    If no join key has been found the function falls back to Block Nested
+    Loops.
+
+  RETURN
+    return one of enum_nested_loop_state.
+*/
+
+enum_nested_loop_state
+JOIN_CACHE_BNL_HASH::join_matching_records(bool skip_last)
+{
+  int error;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+
+  if (!key_parts || skip_last)
+    return JOIN_CACHE_BNL::join_matching_records(skip_last);
+
+  qep_tab->table()->null_row= 0;
+
+  /*
+    Return at once if no record in the join buffer can have a match:
+    records with NULL keys are NULL-complemented by the caller if needed.
+  */
+  if (!hashed_records)
+    return NESTED_LOOP_OK;
+
+  // See setup_join_buffering(=: dynamic range => no cache.
+  DBUG_ASSERT(!(qep_tab->dynamic_range() && qep_tab->quick()));
+
+  const uint32 *const buckets= build_hash_table();
+
+  /* Start retrieving all records of the joined table */
+  if ((error= (*qep_tab->read_first_record)(qep_tab)))
+    return error < 0 ? NESTED_LOOP_OK : NESTED_LOOP_ERROR;
+
+  READ_RECORD *info= &qep_tab->read_record;
+  do
+  {
+    if (qep_tab->keep_current_rowid)
+      qep_tab->table()->file->position(qep_tab->table()->record[0]);
+
+    if (join->thd->killed)
+    {
+      /* The user has aborted the execution of the query */
+      join->thd->send_kill_message();
+      return NESTED_LOOP_KILLED;
+    }
+
+    join->examined_rows++;
+    if (const_cond)
+    {
+      const bool consider_record= const_cond->val_int() != FALSE;
+      if (join->thd->is_error())                // error in condition evaluation
+        return NESTED_LOOP_ERROR;
+      if (!consider_record)
+        continue;
+    }
+
+    uint32 hash;
+    if (key_hash(inner_fields, key_parts, &hash))
+      continue;
+
+    /* Look for matches among the records with the same hash value only */
+    for (uint32 i= buckets[hash % hashed_records]; i; )
+    {
+      const Hash_entry *const entry= hash_entries - i;
+      i= entry->next;
+      if (entry->hash != hash)
+        continue;
+
+      uchar *const rec_ptr= buff + entry->rec_offset;
+      /* 
+        If only the first match is needed and it has been already found for
+        the record then the record is skipped.
+      */
+      if (check_only_first_match && get_match_flag_by_pos(rec_ptr))
+        continue;
+      get_record_by_pos(rec_ptr);
+      rc= generate_full_extensions(rec_ptr);
+      if (rc != NESTED_LOOP_OK)
+        return rc;
+    }
+  } while (!(error= info->read_record(info)));
+
+  if (error > 0)				// Fatal error
+    rc= NESTED_LOOP_ERROR; 
+  return rc;
+}
+
+
 bool JOIN_CACHE::calc_check_only_first_match(const QEP_TAB *t) const
 {
   if ((t->last_sj_inner() == t->idx() &&
@@ -488,7 +488,7 @@ public:
 
   /** Bits describing cache's type @sa setup_join_buffering() */
   enum enum_join_cache_type
-  {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4};
+  {ALG_NONE= 0, ALG_BNL= 1, ALG_BKA= 2, ALG_BKA_UNIQUE= 4, ALG_BNL_HASH= 8};
 
   virtual enum_join_cache_type cache_type() const= 0;
 
@@ -497,6 +497,7 @@ public:
   { return cache_type() & (ALG_BKA | ALG_BKA_UNIQUE ); }
 
   friend class JOIN_CACHE_BNL;
+  friend class JOIN_CACHE_BNL_HASH;
   friend class JOIN_CACHE_BKA;
   friend class JOIN_CACHE_BKA_UNIQUE;
 };
@@ -519,10 +520,122 @@ public:
 
   enum_join_cache_type cache_type() const { return ALG_BNL; }
 
-private:
+protected:
   Item *const_cond;
 };
 
+
+/*
+  The class JOIN_CACHE_BNL_HASH is used for equi-joins that would otherwise
+  be executed with Block Nested Loops because there is no usable index on
+  the joined table.
+
+  The records of the outer tables are accumulated in the join buffer as
+  for BNL. When a record is put into the buffer the hash value of its join
+  key (the outer fields of the equalities between the joined table and the
+  buffered tables) is saved in an entry at the end of the buffer. The
+  entries grow towards the records:
+
+  +-------------------------------------------------------------------+
+  | rec_1 | rec_2 | ... | rec_n | ->  free <- | buckets | e_n ... e_1 |
+  +-------------------------------------------------------------------+
+
+  Each entry contains the offset of the record and the hash value. When the
+  buffer is full (or there are no more outer records) the entries are
+  linked into hash chains and the joined table is scanned once: for each
+  of its records only the buffered records in the chain of the hash value
+  of its own join key are read back and checked against the attached
+  condition. The hash value is a filter only; a match is still decided by
+  check_match() so hash collisions are harmless.
+
+  Records with a NULL in the join key get no entry: they cannot match, but
+  they remain in the buffer to be NULL-complemented by an outer join.
+
+  When the outer records do not fit in the join buffer they are processed
+  in chunks of join_buffer_size, one scan of the joined table per chunk,
+  exactly as for BNL.
+*/
+
+class JOIN_CACHE_BNL_HASH :public JOIN_CACHE_BNL
+{
+private:
+
+  /* Entry of the hash table, one per buffered record with a non-NULL key */
+  struct Hash_entry
+  {
+    /* Offset of the fields of the record from the start of the buffer */
+    ulong rec_offset;
+    /* Hash value of the join key of the record */
+    uint32 hash;
+    /* Number of the next entry in the hash chain, 0 ends the chain */
+    uint32 next;
+  };
+
+  /* Fields of the joined table used in the join key */
+  Field **inner_fields;
+  /* Fields of the buffered tables compared with inner_fields */
+  Field **outer_fields;
+  /* Number of parts of the join key */
+  uint key_parts;
+
+  /* End of the hash entries, aligned, entry i is at hash_entries[-i] */
+  Hash_entry *hash_entries;
+  /* Number of the entries in the hash table */
+  uint32 hashed_records;
+
+  /* Space reserved at the end of the buffer for each record */
+  static uint hash_entry_space()
+  { return sizeof(Hash_entry) + sizeof(uint32); }
+
+  static bool key_hash(Field **fields, uint n, uint32 *hash);
+
+  /* Link the hash entries into chains and return the bucket array */
+  uint32 *build_hash_table();
+
+protected:
+
+  uint aux_buffer_min_size() const
+  { return hash_entry_space() + sizeof(ulong); }
+
+  ulong rem_space()
+  {
+    const ulong used= (end_pos - buff) +
+                      (records + 1) * hash_entry_space() + sizeof(ulong);
+    return used < buff_size ? buff_size - used : 0;
+  }
+
+  bool put_record_in_cache();
+
+  /* Using the hash table find matches from the next table for records */
+  enum_nested_loop_state join_matching_records(bool skip_last);
+
+public:
+  JOIN_CACHE_BNL_HASH(JOIN *j, QEP_TAB *qep_tab_arg, JOIN_CACHE *prev)
+    : JOIN_CACHE_BNL(j, qep_tab_arg, prev), inner_fields(NULL),
+      outer_fields(NULL), key_parts(0), hash_entries(NULL), hashed_records(0)
+  {}
+
+  /* Initialize the hash join cache */
+  int init();
+
+  void reset_cache(bool for_writing);
+
+  enum_join_cache_type cache_type() const { return ALG_BNL_HASH; }
+
+  /* Check whether f1=f2 can be checked by comparing hash values */
+  static bool fields_are_hashable(const Field *f1, const Field *f2);
+
+  /* Check whether a predicate can be a part of the hash join key */
+  static bool is_key_equality(Item *item, table_map inner_map,
+                              table_map outer_map,
+                              Field **inner_field, Field **outer_field);
+
+  /* Collect the hash join key from the conjuncts of a condition */
+  static uint find_keys(Item *cond, plan_idx idx, table_map inner_map,
+                        table_map outer_map, Field **inner_fields,
+                        Field **outer_fields, uint n_keys);
+};
+
 class JOIN_CACHE_BKA :public JOIN_CACHE
 {
 protected:
@@ -3098,6 +3098,25 @@ static bool setup_join_buffering(JOIN_TAB *tab, JOIN *join, uint no_jbuf_after)
     }
 
     tab->set_use_join_cache(JOIN_CACHE::ALG_BNL);
+
+    /*
+      Use a hash join instead of Block Nested Loops if the condition
+      attached to the table has equalities with columns of the tables
+      whose records will be in the join buffer.
+    */
+    if (join->thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN))
+    {
+      const uint first=
+        sj_is_materialize_strategy(tab_sj_strategy) ?
+        tab->first_sj_inner() : join->const_tables;
+      table_map outer_map= 0;
+      for (uint i= first; i < tableno; i++)
+        outer_map|= join->best_ref[i]->table_ref->map();
+      if (JOIN_CACHE_BNL_HASH::find_keys(tab->condition(), tab->idx(),
+                                         tab->table_ref->map(), outer_map,
+                                         NULL, NULL, 0))
+        tab->set_use_join_cache(JOIN_CACHE::ALG_BNL_HASH);
+    }
     return false;
   case JT_SYSTEM:
   case JT_CONST:
@@ -33,6 +33,7 @@
 #include "merge_sort.h"
 #include <my_bit.h>
 #include "opt_hints.h"   // hint_table_state()
+#include "sql_join_buffer.h" // JOIN_CACHE_BNL_HASH
 #include "parse_tree_hints.h"
 
 #include <algorithm>
@@ -694,6 +695,55 @@ Key_use* Optimize_table_order::find_best_ref(const JOIN_TAB *tab,
   return best_ref;
 }
 
+/**
+  Estimate how much a hash join reduces the number of record combinations
+  that are checked against the join condition.
+
+  With a hash join, a record of 'tab' is checked only against the buffered
+  records with the same values of the columns in the equalities between
+  'tab' and the tables of the partial plan. The returned value is the
+  combined filtering effect of these equalities.
+
+  @param tab            the table to be joined
+  @param prefix_tables  the non-const tables of the partial plan
+
+  @return the filtering effect, or COND_FILTER_ALLPASS if no equality in
+          the WHERE condition can be used as a hash join key
+*/
+
+static float hash_join_filter(const JOIN_TAB *tab, table_map prefix_tables)
+{
+  Item *const cond= tab->join()->where_cond;
+  if (cond == NULL || prefix_tables == 0 ||
+      tab->table_ref->outer_join_nest() != NULL ||
+      tab->records() < 1.0)
+    return COND_FILTER_ALLPASS;
+
+  TABLE *const table= tab->table();
+  const table_map map= tab->table_ref->map();
+  const bool is_and=
+    cond->type() == Item::COND_ITEM &&
+    static_cast<Item_cond *>(cond)->functype() == Item_func::COND_AND_FUNC;
+  List_iterator<Item> li;
+  if (is_and)
+    li.init(*static_cast<Item_cond *>(cond)->argument_list());
+
+  // No fields to ignore, see calculate_condition_filter()
+  DBUG_ASSERT(bitmap_is_clear_all(&table->tmp_set));
+
+  float filter= COND_FILTER_ALLPASS;
+  for (Item *item= is_and ? li++ : cond; item; item= is_and ? li++ : NULL)
+  {
+    Field *inner_field, *outer_field;
+    if (JOIN_CACHE_BNL_HASH::is_key_equality(item, map, prefix_tables,
+                                             &inner_field, &outer_field))
+      filter*= item->get_filtering_effect(map, prefix_tables,
+                                          &table->tmp_set,
+                                          static_cast<double>(tab->records()));
+  }
+  return filter;
+}
+
 /**
   Calculate the cost of range/table/index scanning table 'tab'.
 
@@ -719,8 +769,13 @@ Key_use* Optimize_table_order::find_best_ref(const JOIN_TAB *tab,
                               that filters away rows for this table.
                               @see find_best_ref()
   @param disable_jbuf         don't use join buffering if true
+  @param prefix_tables        non-const tables of the partial plan
   @param[out] rows_after_filtering fanout of the access method after taking
                               condition filtering into account
+  @param[out] hash_filter     share of the combinations of 'tab' records
+                              and prefix records that a hash join checks
+                              against the join condition, 1.0 if no hash
+                              join is used
   @param trace_access_scan    The optimizer trace object info is appended to
 
   @return                     Cost of fetching rows from the storage
@@ -735,13 +790,16 @@ Optimize_table_order::calculate_scan_cost(const JOIN_TAB *tab,
                                           const double prefix_rowcount,
                                           const bool found_condition,
                                           const bool disable_jbuf,
+                                          const table_map prefix_tables,
                                           double *rows_after_filtering,
+                                          float *hash_filter,
                                           Opt_trace_object *trace_access_scan)
 {
   double scan_and_filter_cost;
   TABLE *const table= tab->table();
   const Cost_model_server *const cost_model= join->cost_model();
   *rows_after_filtering= static_cast<double>(tab->found_records);
+  *hash_filter= COND_FILTER_ALLPASS;
 
   trace_access_scan->add("rows_to_scan", tab->found_records);
 
@@ -871,6 +929,24 @@ Optimize_table_order::calculate_scan_cost(const JOIN_TAB *tab,
 
       trace_access_scan->add("using_join_cache", true);
       trace_access_scan->add("buffers_needed", (ulong)buffer_count);
+
+      /*
+        A hash join inserts all prefix rows into hash tables and looks up
+        every scanned row that passes the attached conditions once per
+        buffer. Only the matches found in the hash tables are then joined
+        with the prefix rows, see best_access_path().
+      */
+      if (thd->optimizer_switch_flag(OPTIMIZER_SWITCH_HASH_JOIN))
+      {
+        *hash_filter= hash_join_filter(tab, prefix_tables);
+        if (*hash_filter < COND_FILTER_ALLPASS)
+        {
+          scan_and_filter_cost+=
+            cost_model->hash_join_cost(prefix_rowcount,
+                                       buffer_count * *rows_after_filtering);
+          trace_access_scan->add("using_hash_join", true);
+        }
+      }
     }
   }
 
@@ -1053,6 +1129,7 @@ void Optimize_table_order::best_access_path(JOIN_TAB *tab,
       therefore has to be compared to the cost of scanning.
     */
     double rows_after_filtering;
+    float hash_filter;
 
     double scan_read_cost= calculate_scan_cost(tab,
                                                idx,
@@ -1060,17 +1137,29 @@ void Optimize_table_order::best_access_path(JOIN_TAB *tab,
                                                prefix_rowcount,
                                                found_condition,
                                                disable_jbuf,
+                                               ~remaining_tables &
+                                               ~excluded_tables &
+                                               ~join->const_table_map,
                                                &rows_after_filtering,
+                                               &hash_filter,
                                                &trace_access_scan);
 
+    /*
+      With a hash join, a prefix row is checked only against the found
+      records that have the same join key. This reduces the cost of
+      evaluating the condition, but not the number of records fetched
+      or the fanout, which the condition filter already accounts for.
+    */
+    const double rows_to_check= rows_after_filtering * hash_filter;
+
     /*
       We estimate the cost of evaluating WHERE clause for found
-      records as row_evaluate_cost(prefix_rowcount * rows_after_filtering).
+      records as row_evaluate_cost(prefix_rowcount * rows_to_check).
       This cost plus scan_cost gives us total cost of using
       TABLE/INDEX/RANGE SCAN.
     */
     const double scan_total_cost= scan_read_cost +
-      cost_model->row_evaluate_cost(prefix_rowcount * rows_after_filtering);
+      cost_model->row_evaluate_cost(prefix_rowcount * rows_to_check);
 
     trace_access_scan.add("resulting_rows", rows_after_filtering);
     trace_access_scan.add("cost", scan_total_cost);
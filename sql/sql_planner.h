@@ -121,7 +121,9 @@ private:
                              const double prefix_rowcount,
                              const bool found_condition,
                              const bool disable_jbuf,
+                             const table_map prefix_tables,
                              double *rows_after_filtering,
+                             float *hash_filter,
                              Opt_trace_object *trace_access_scan);
   void best_access_path(JOIN_TAB *tab,
                         const table_map remaining_tables,
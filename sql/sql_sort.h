@@ -34,6 +34,11 @@ class Filesort;
 
 #define MERGEBUFF		7
 #define MERGEBUFF2		15
+/*
+  Smallest read-ahead buffer per chunk when filesort merges more than
+  MERGEBUFF2 chunks at a time.
+*/
+#define MERGE_READ_MIN_SIZE	(2 * IO_SIZE)
 
 /* Structs used when sorting */
 
@@ -310,6 +315,7 @@ public:
   bool not_killable;
   bool using_pq;
   char* tmp_buffer;
+  uint sort_threads;          // Max threads sorting the sort buffer.
 
   // The fields below are used only by Unique class.
   Merge_chunk_compare_context cmp_context;
@@ -1033,14 +1033,17 @@ update_hidden:
   share->fields= field_count;
   share->blob_fields= blob_count;
 
-  /* If result table is small; use a heap */
+  /*
+    If result table is small; use a heap. INFORMATION_SCHEMA tables with
+    blobs are still created in the on-disk engine.
+  */
   if (select_options & TMP_TABLE_FORCE_MYISAM)
   {
     share->db_plugin= ha_lock_engine(0, myisam_hton);
     table->file= get_new_handler(share, &table->mem_root,
                                  share->db_type());
   }
-  else if (blob_count ||
+  else if ((blob_count && param->schema_table) ||
            (thd->variables.big_tables &&
             !(select_options & SELECT_SMALL_RESULT)))
   {
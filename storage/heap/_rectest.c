@@ -22,7 +22,15 @@ int hp_rectest(HP_INFO *info, const uchar *old)
 {
   DBUG_ENTER("hp_rectest");
 
-  if (memcmp(info->current_ptr,old,(size_t) info->s->reclength))
+  if (info->s->columns)
+  {
+    int error= hp_packed_cmp(info, old, info->current_ptr);
+    if (error < 0)
+      DBUG_RETURN(my_errno);
+    if (error)
+      DBUG_RETURN((my_errno=HA_ERR_RECORD_CHANGED));
+  }
+  else if (memcmp(info->current_ptr,old,(size_t) info->s->reclength))
   {
     DBUG_RETURN((my_errno=HA_ERR_RECORD_CHANGED)); /* Record have changed */
   }
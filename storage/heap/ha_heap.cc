@@ -643,29 +643,80 @@ ha_rows ha_heap::records_in_range(uint inx, key_range *min_key,
 }
 
 
+static int columndef_cmp(const void *a, const void *b)
+{
+  uint offset_a= static_cast<const HP_COLUMNDEF*>(a)->offset;
+  uint offset_b= static_cast<const HP_COLUMNDEF*>(b)->offset;
+  return offset_a < offset_b ? -1 : (offset_a > offset_b ? 1 : 0);
+}
+
+
+/*
+  Describe the columns of a table to the MEMORY engine, which uses them
+  to store long VARCHAR and BLOB columns in a packed format.
+*/
+
+static void
+heap_prepare_columndef(TABLE *table_arg, HP_COLUMNDEF *columndef)
+{
+  TABLE_SHARE *share= table_arg->s;
+
+  for (uint i= 0; i < share->fields; i++)
+  {
+    Field *field= table_arg->field[i];
+    HP_COLUMNDEF *column= columndef + i;
+
+    column->offset= field->offset(table_arg->record[0]);
+    column->length= field->pack_length();
+    column->length_bytes= 0;
+    if (field->flags & BLOB_FLAG)
+    {
+      Field_blob *blob= static_cast<Field_blob*>(field);
+      column->type= HP_COLUMN_BLOB;
+      column->length_bytes= static_cast<uint8>(blob->pack_length_no_ptr());
+    }
+    else if (field->real_type() == MYSQL_TYPE_VARCHAR)
+    {
+      Field_varstring *varstring= static_cast<Field_varstring*>(field);
+      column->type= HP_COLUMN_VARCHAR;
+      column->length_bytes= static_cast<uint8>(varstring->length_bytes);
+    }
+    else
+      column->type= HP_COLUMN_FIXED;
+  }
+  my_qsort(columndef, share->fields, sizeof(HP_COLUMNDEF), columndef_cmp);
+}
+
+
 static int
 heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
                             HP_CREATE_INFO *hp_create_info)
 {
   uint key, parts, mem_per_row= 0, keys= table_arg->s->keys;
-  uint auto_key= 0, auto_key_type= 0;
+  uint auto_key= 0, auto_key_type= 0, fixed_length;
   ha_rows max_rows;
   HP_KEYDEF *keydef;
   HA_KEYSEG *seg;
+  HP_COLUMNDEF *columndef;
   TABLE_SHARE *share= table_arg->s;
   bool found_real_auto_increment= 0;
+  bool packed;
 
   memset(hp_create_info, 0, sizeof(*hp_create_info));
 
   for (key= parts= 0; key < keys; key++)
     parts+= table_arg->key_info[key].user_defined_key_parts;
 
+  /* The column definitions are freed together with keydef */
   if (!(keydef= (HP_KEYDEF*) my_malloc(hp_key_memory_HP_KEYDEF,
                                        keys * sizeof(HP_KEYDEF) +
-				       parts * sizeof(HA_KEYSEG),
+				       parts * sizeof(HA_KEYSEG) +
+				       share->fields * sizeof(HP_COLUMNDEF),
 				       MYF(MY_WME))))
     return my_errno;
   seg= reinterpret_cast<HA_KEYSEG*>(keydef + keys);
+  columndef= reinterpret_cast<HP_COLUMNDEF*>(seg + parts);
+  heap_prepare_columndef(table_arg, columndef);
   for (key= 0; key < keys; key++)
   {
     KEY *pos= table_arg->key_info+key;
@@ -736,7 +787,20 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
       }
     }
   }
-  mem_per_row+= MY_ALIGN(share->reclength + 1, sizeof(char*));
+  hp_create_info->keys= share->keys;
+  hp_create_info->reclength= share->reclength;
+  hp_create_info->keydef= keydef;
+  hp_create_info->columndef= columndef;
+  hp_create_info->columns= share->fields;
+  /*
+    A packed record takes a pointer to its chunks in the record block,
+    and at least one chunk.
+  */
+  if ((packed= heap_packed_record(hp_create_info, &fixed_length)))
+    mem_per_row+= MY_ALIGN(fixed_length + sizeof(uchar*) + 1, sizeof(char*)) +
+                  HP_CHUNK_LENGTH;
+  else
+    mem_per_row+= MY_ALIGN(share->reclength + 1, sizeof(char*));
   if (table_arg->found_next_number_field)
   {
     keydef[share->next_number_index].flag|= HA_AUTO_KEY;
@@ -748,15 +812,22 @@ heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->with_auto_increment= found_real_auto_increment;
   hp_create_info->internal_table= internal_table;
 
+  /*
+    The row limit of an internal temporary table assumes that every row
+    takes share->reclength bytes. Packed rows take less, so limit such
+    tables by the memory they use instead.
+  */
+  if (packed && internal_table)
+    set_if_smaller(hp_create_info->max_table_size,
+                   current_thd->variables.tmp_table_size);
+
   max_rows= (ha_rows) (hp_create_info->max_table_size / mem_per_row);
-  if (share->max_rows && share->max_rows < max_rows)
+  if (share->max_rows && share->max_rows < max_rows &&
+      !(packed && internal_table))
     max_rows= share->max_rows;
 
   hp_create_info->max_records= (ulong) max_rows;
   hp_create_info->min_records= (ulong) share->min_rows;
-  hp_create_info->keys= share->keys;
-  hp_create_info->reclength= share->reclength;
-  hp_create_info->keydef= keydef;
   return 0;
 }
 
@@ -34,6 +34,17 @@ C_MODE_START
 #define HP_MIN_RECORDS_IN_BLOCK 16
 #define HP_MAX_RECORDS_IN_BLOCK 8192
 
+/*
+  Records are packed if there is a BLOB column, or a VARCHAR column of at
+  least HP_MIN_VAR_COLUMN_LENGTH bytes behind all key segments. The
+  packed part is stored in chunks of HP_CHUNK_DATA_LENGTH bytes, each
+  preceded by a pointer to the next chunk.
+*/
+
+#define HP_MIN_VAR_COLUMN_LENGTH 64
+#define HP_CHUNK_DATA_LENGTH 64
+#define HP_CHUNK_LENGTH (sizeof(uchar*) + HP_CHUNK_DATA_LENGTH)
+
 	/* Some extern variables */
 
 extern LIST *heap_open_list,*heap_share_list;
@@ -97,6 +108,18 @@ extern uint hp_rb_key_length(HP_KEYDEF *keydef, const uchar *key);
 extern uint hp_rb_null_key_length(HP_KEYDEF *keydef, const uchar *key);
 extern uint hp_rb_var_key_length(HP_KEYDEF *keydef, const uchar *key);
 extern my_bool hp_if_null_in_key(HP_KEYDEF *keyinfo, const uchar *record);
+extern int hp_write_chunks(HP_INFO *info, const uchar *record,
+                           uchar **chunks);
+extern int hp_extend_chunks(HP_INFO *info, const uchar *record,
+                            const uchar *pos, uchar **extra);
+extern void hp_rewrite_chunks(HP_INFO *info, uchar *pos, uchar *extra);
+extern void hp_free_chunks(HP_SHARE *share, uchar *chunks);
+extern void hp_store_record(HP_SHARE *share, uchar *pos, const uchar *record,
+                            uchar *chunks);
+extern uchar *hp_record_chunks(HP_SHARE *share, const uchar *pos);
+extern int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos);
+extern int hp_packed_cmp(HP_INFO *info, const uchar *record,
+                         const uchar *pos);
 extern int hp_close(HP_INFO *info);
 extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
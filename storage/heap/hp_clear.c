@@ -35,6 +35,12 @@ void hp_clear(HP_SHARE *info)
     (void) hp_free_level(&info->block,info->block.levels,info->block.root,
 			(uchar*) 0);
   info->block.levels=0;
+  if (info->chunk_block.levels)
+    (void) hp_free_level(&info->chunk_block,info->chunk_block.levels,
+			 info->chunk_block.root,(uchar*) 0);
+  info->chunk_block.levels=0;
+  info->chunks=0;
+  info->chunk_del_link=0;
   hp_clear_keys(info);
   info->records= info->deleted= 0;
   info->data_length= 0;
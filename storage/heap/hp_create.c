@@ -18,13 +18,15 @@
 static int keys_compare(heap_rb_param *param, uchar *key1, uchar *key2);
 static void init_block(HP_BLOCK *block,uint reclength,ulong min_records,
 		       ulong max_records);
+static uint packed_columns(const HP_CREATE_INFO *create_info,
+                           uint fixed_length, HP_COLUMNDEF *columndef);
 
 /* Create a heap table */
 
 int heap_create(const char *name, HP_CREATE_INFO *create_info,
                 HP_SHARE **res, my_bool *created_new_share)
 {
-  uint i, j, key_segs, max_length, length;
+  uint i, j, key_segs, max_length, length, fixed_length, columns;
   HP_SHARE *share= 0;
   HA_KEYSEG *keyseg;
   HP_KEYDEF *keydef= create_info->keydef;
@@ -56,7 +58,16 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
       so the record length should be at least sizeof(uchar*)
     */
     set_if_bigger(reclength, sizeof (uchar*));
-    
+
+    /* Long VARCHAR and BLOB columns are packed into chunks */
+    if (heap_packed_record(create_info, &fixed_length))
+      columns= packed_columns(create_info, fixed_length, NULL);
+    else
+    {
+      fixed_length= reclength;
+      columns= 0;
+    }
+
     for (i= key_segs= max_length= 0, keyinfo= keydef; i < keys; i++, keyinfo++)
     {
       memset(&keyinfo->block, 0, sizeof(keyinfo->block));
@@ -134,13 +145,27 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     if (!(share= (HP_SHARE*) my_malloc(hp_key_memory_HP_SHARE,
                                        (uint) sizeof(HP_SHARE)+
 				       keys*sizeof(HP_KEYDEF)+
-				       key_segs*sizeof(HA_KEYSEG),
+				       key_segs*sizeof(HA_KEYSEG)+
+				       columns*sizeof(HP_COLUMNDEF),
 				       MYF(MY_ZEROFILL))))
       goto err;
     share->keydef= (HP_KEYDEF*) (share + 1);
     share->key_stat_version= 1;
     keyseg= (HA_KEYSEG*) (share->keydef + keys);
-    init_block(&share->block, reclength + 1, min_records, max_records);
+    share->columndef= (HP_COLUMNDEF*) (keyseg + key_segs);
+    share->columns= columns;
+    share->fixed_length= fixed_length;
+    if (columns)
+    {
+      (void) packed_columns(create_info, fixed_length, share->columndef);
+      /* The record block keeps a pointer to the first chunk */
+      share->visible= fixed_length + sizeof(uchar*);
+      init_block(&share->chunk_block, HP_CHUNK_LENGTH, min_records,
+                 max_records);
+    }
+    else
+      share->visible= reclength;
+    init_block(&share->block, share->visible + 1, min_records, max_records);
 	/* Fix keys */
     memcpy(share->keydef, keydef, (size_t) (sizeof(keydef[0]) * keys));
     for (i= 0, keyinfo= share->keydef; i < keys; i++, keyinfo++)
@@ -226,6 +251,133 @@ err:
 } /* heap_create */
 
 
+/*
+  Decide how the records of a table are stored
+
+  SYNOPSIS
+    heap_packed_record()
+    create_info             Table definition
+    fixed_length      OUT   Bytes of a record kept in the record block
+
+  DESCRIPTION
+    Records are packed if there is a BLOB column, or a VARCHAR column of
+    at least HP_MIN_VAR_COLUMN_LENGTH bytes behind all key segments.
+    The record block keeps the record up to the first such column. All
+    columns from there on, and BLOB columns in front of it, are packed
+    and stored in chunks.
+
+  RETURN
+    TRUE   Records are packed
+    FALSE  Records are stored with their full length
+*/
+
+my_bool heap_packed_record(const HP_CREATE_INFO *create_info,
+                           uint *fixed_length)
+{
+  uint i, j, key_end= 0;
+  my_bool found= FALSE, has_blob= FALSE;
+  const HP_KEYDEF *keyinfo;
+  const HP_COLUMNDEF *column, *end;
+
+  for (i= 0, keyinfo= create_info->keydef; i < create_info->keys;
+       i++, keyinfo++)
+  {
+    for (j= 0; j < keyinfo->keysegs; j++)
+    {
+      const HA_KEYSEG *seg= keyinfo->seg + j;
+      uint seg_end= seg->start + seg->length;
+      if (seg->flag & HA_VAR_LENGTH_PART)
+        seg_end+= 2;                            /* Length bytes */
+      set_if_bigger(key_end, seg_end);
+    }
+  }
+
+  *fixed_length= create_info->reclength;
+  for (column= create_info->columndef, end= column + create_info->columns;
+       column < end; column++)
+  {
+    my_bool is_var= (column->type == HP_COLUMN_BLOB ||
+                     (column->type == HP_COLUMN_VARCHAR &&
+                      column->length >= HP_MIN_VAR_COLUMN_LENGTH));
+    if (column->type == HP_COLUMN_BLOB)
+      has_blob= TRUE;
+    if (is_var && !found && column->offset >= key_end)
+    {
+      *fixed_length= column->offset;
+      found= TRUE;
+    }
+  }
+  return found || has_blob;
+}
+
+
+/*
+  Find the columns of the packed part of a record
+
+  SYNOPSIS
+    packed_columns()
+    create_info             Table definition, columns ordered by offset
+    fixed_length            Bytes of a record kept in the record block
+    columndef         OUT   Packed columns, or NULL to only count them
+
+  DESCRIPTION
+    Bytes behind fixed_length that are not part of any column are
+    packed as fixed length columns, so that the whole record is kept.
+
+  RETURN
+    Number of packed columns
+*/
+
+static uint packed_columns(const HP_CREATE_INFO *create_info,
+                           uint fixed_length, HP_COLUMNDEF *columndef)
+{
+  uint count= 0, offset= fixed_length;
+  const HP_COLUMNDEF *column, *end;
+
+  for (column= create_info->columndef, end= column + create_info->columns;
+       column < end; column++)
+  {
+    if (column->offset < fixed_length)
+    {
+      /* BLOB data is never kept in the record block */
+      if (column->type != HP_COLUMN_BLOB)
+        continue;
+    }
+    else
+    {
+      DBUG_ASSERT(column->offset >= offset);
+      if (column->offset > offset)
+      {
+        if (columndef)
+        {
+          columndef[count].offset= offset;
+          columndef[count].length= column->offset - offset;
+          columndef[count].type= HP_COLUMN_FIXED;
+          columndef[count].length_bytes= 0;
+        }
+        count++;
+      }
+      offset= column->offset + column->length;
+    }
+    if (columndef)
+      columndef[count]= *column;
+    count++;
+  }
+  if (offset < create_info->reclength)
+  {
+    if (columndef)
+    {
+      columndef[count].offset= offset;
+      columndef[count].length= create_info->reclength - offset;
+      columndef[count].type= HP_COLUMN_FIXED;
+      columndef[count].length_bytes= 0;
+    }
+    count++;
+  }
+  return count;
+}
+
+
 static int keys_compare(heap_rb_param *param, uchar *key1, uchar *key2)
 {
   uint not_used[2];
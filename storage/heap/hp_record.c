@@ -0,0 +1,507 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Store and read records with a packed part
+
+  The packed part of a record starts with its total length in 4 bytes,
+  followed by the packed columns of share->columndef:
+    HP_COLUMN_FIXED    All bytes of the column
+    HP_COLUMN_VARCHAR  Length bytes and the used part of the value
+    HP_COLUMN_BLOB     Length bytes and the data the column points to
+  It is stored in a chain of chunks from share->chunk_block. A chunk
+  starts with a pointer to the next chunk, followed by up to
+  HP_CHUNK_DATA_LENGTH bytes of data. The record block keeps a pointer
+  to the first chunk behind the first share->fixed_length bytes of the
+  record.
+*/
+
+#include "heapdef.h"
+
+#define PACKED_LENGTH_BYTES 4
+
+
+/* Get the length of a VARCHAR or BLOB value */
+
+static ulong var_length(uint length_bytes, const uchar *pos)
+{
+  switch (length_bytes) {
+  case 1:
+    return (ulong) *pos;
+  case 2:
+    return (ulong) uint2korr(pos);
+  case 3:
+    return (ulong) uint3korr(pos);
+  case 4:
+    return (ulong) uint4korr(pos);
+  default:
+    DBUG_ASSERT(0);
+  }
+  return 0;
+}
+
+
+/* Get the number of bytes the value of a VARCHAR column takes */
+
+static ulong varchar_length(const HP_COLUMNDEF *column, const uchar *pos)
+{
+  ulong length= var_length(column->length_bytes, pos);
+  set_if_smaller(length, column->length - column->length_bytes);
+  return length;
+}
+
+
+/* Get the length of the packed part of a record */
+
+static ulong packed_length(HP_SHARE *share, const uchar *record)
+{
+  ulong length= PACKED_LENGTH_BYTES;
+  const HP_COLUMNDEF *column, *end;
+
+  for (column= share->columndef, end= column + share->columns;
+       column < end; column++)
+  {
+    const uchar *pos= record + column->offset;
+    switch (column->type) {
+    case HP_COLUMN_VARCHAR:
+      length+= column->length_bytes + varchar_length(column, pos);
+      break;
+    case HP_COLUMN_BLOB:
+      length+= column->length_bytes + var_length(column->length_bytes, pos);
+      break;
+    default:
+      length+= column->length;
+      break;
+    }
+  }
+  return length;
+}
+
+
+/* Pack the columns of a record into a buffer of packed_length() bytes */
+
+static void pack_record(HP_SHARE *share, uchar *to, const uchar *record,
+                        ulong length)
+{
+  const HP_COLUMNDEF *column, *end;
+
+  int4store(to, length);
+  to+= PACKED_LENGTH_BYTES;
+  for (column= share->columndef, end= column + share->columns;
+       column < end; column++)
+  {
+    const uchar *pos= record + column->offset;
+    switch (column->type) {
+    case HP_COLUMN_VARCHAR:
+    {
+      ulong data_length= varchar_length(column, pos);
+      if (column->length_bytes == 1)
+        *to= (uchar) data_length;
+      else
+        int2store(to, data_length);
+      to+= column->length_bytes;
+      memcpy(to, pos + column->length_bytes, data_length);
+      to+= data_length;
+      break;
+    }
+    case HP_COLUMN_BLOB:
+    {
+      ulong data_length= var_length(column->length_bytes, pos);
+      const uchar *data;
+      memcpy(to, pos, column->length_bytes);
+      to+= column->length_bytes;
+      memcpy(&data, pos + column->length_bytes, sizeof(data));
+      if (data_length)
+        memcpy(to, data, data_length);
+      to+= data_length;
+      break;
+    }
+    default:
+      memcpy(to, pos, column->length);
+      to+= column->length;
+      break;
+    }
+  }
+}
+
+
+/*
+  Unpack columns into a record. BLOB columns will point into the packed
+  data.
+*/
+
+static void unpack_record(HP_SHARE *share, uchar *record, const uchar *from)
+{
+  const HP_COLUMNDEF *column, *end;
+
+  from+= PACKED_LENGTH_BYTES;
+  for (column= share->columndef, end= column + share->columns;
+       column < end; column++)
+  {
+    uchar *pos= record + column->offset;
+    switch (column->type) {
+    case HP_COLUMN_VARCHAR:
+    {
+      ulong length= column->length_bytes + var_length(column->length_bytes,
+                                                      from);
+      memcpy(pos, from, length);
+      from+= length;
+      break;
+    }
+    case HP_COLUMN_BLOB:
+    {
+      ulong data_length= var_length(column->length_bytes, from);
+      memcpy(pos, from, column->length_bytes);
+      from+= column->length_bytes;
+      memcpy(pos + column->length_bytes, &from, sizeof(from));
+      from+= data_length;
+      break;
+    }
+    default:
+      memcpy(pos, from, column->length);
+      from+= column->length;
+      break;
+    }
+  }
+}
+
+
+/* Make a buffer of HP_INFO at least length bytes long */
+
+static my_bool alloc_buffer(uchar **buff, size_t *buff_length, size_t length)
+{
+  if (length > *buff_length)
+  {
+    uchar *new_buff;
+    size_t new_length= MY_MAX(length, 2 * *buff_length);
+    if (!(new_buff= (uchar*) my_realloc(hp_key_memory_HP_INFO, *buff,
+                                        new_length,
+                                        MYF(MY_WME | MY_ALLOW_ZERO_PTR))))
+      return TRUE;
+    *buff= new_buff;
+    *buff_length= new_length;
+  }
+  return FALSE;
+}
+
+
+/* Find where to place a new chunk */
+
+static uchar *next_free_chunk(HP_SHARE *share)
+{
+  uint block_pos;
+  uchar *pos;
+  size_t length;
+  DBUG_ENTER("next_free_chunk");
+
+  if (share->chunk_del_link)
+  {
+    pos= share->chunk_del_link;
+    share->chunk_del_link= *((uchar**) pos);
+    DBUG_RETURN(pos);
+  }
+  if (!(block_pos= (share->chunks % share->chunk_block.records_in_block)))
+  {
+    if (share->data_length + share->index_length >= share->max_table_size)
+    {
+      my_errno= HA_ERR_RECORD_FILE_FULL;
+      DBUG_RETURN(NULL);
+    }
+    if (hp_get_new_block(&share->chunk_block, &length))
+      DBUG_RETURN(NULL);
+    share->data_length+= length;
+  }
+  share->chunks++;
+  DBUG_RETURN((uchar*) share->chunk_block.level_info[0].last_blocks +
+              block_pos * share->chunk_block.recbuffer);
+}
+
+
+/*
+  Store the packed part of a record in new chunks
+
+  SYNOPSIS
+    hp_write_chunks()
+    info                Heap table info
+    record              Record to store
+    chunks        OUT   First chunk of the chain
+
+  RETURN
+    0  ok
+    #  error; no chunks were allocated
+*/
+
+int hp_write_chunks(HP_INFO *info, const uchar *record, uchar **chunks)
+{
+  HP_SHARE *share= info->s;
+  ulong length= packed_length(share, record);
+  const uchar *from;
+  uchar **link= chunks;
+  DBUG_ENTER("hp_write_chunks");
+
+  *chunks= NULL;
+  if (alloc_buffer(&info->pack_buff, &info->pack_buff_length, length))
+    DBUG_RETURN(my_errno);
+  pack_record(share, info->pack_buff, record, length);
+
+  for (from= info->pack_buff; length; )
+  {
+    ulong chunk_length= MY_MIN(length, HP_CHUNK_DATA_LENGTH);
+    uchar *chunk= next_free_chunk(share);
+    if (!chunk)
+    {
+      hp_free_chunks(share, *chunks);
+      *chunks= NULL;
+      DBUG_RETURN(my_errno);
+    }
+    *((uchar**) chunk)= NULL;
+    *link= chunk;
+    link= (uchar**) chunk;
+    memcpy(chunk + sizeof(uchar*), from, chunk_length);
+    from+= chunk_length;
+    length-= chunk_length;
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Prepare to replace the packed part of a record
+
+  SYNOPSIS
+    hp_extend_chunks()
+    info                Heap table info
+    record              New record
+    pos                 Record in the record block
+    extra         OUT   Chunks to append to the chain of the record
+
+  NOTES
+    The new packed part is kept in info->pack_buff for
+    hp_rewrite_chunks(). No chunks are allocated if it fits in the
+    chunks the record already has.
+
+  RETURN
+    0  ok
+    #  error; no chunks were allocated
+*/
+
+int hp_extend_chunks(HP_INFO *info, const uchar *record, const uchar *pos,
+                     uchar **extra)
+{
+  HP_SHARE *share= info->s;
+  ulong length= packed_length(share, record);
+  ulong missing= (length + HP_CHUNK_DATA_LENGTH - 1) / HP_CHUNK_DATA_LENGTH;
+  const uchar *chunk;
+  uchar **link= extra;
+  DBUG_ENTER("hp_extend_chunks");
+
+  *extra= NULL;
+  if (alloc_buffer(&info->pack_buff, &info->pack_buff_length, length))
+    DBUG_RETURN(my_errno);
+  pack_record(share, info->pack_buff, record, length);
+
+  for (chunk= hp_record_chunks(share, pos); chunk && missing;
+       chunk= *((const uchar**) chunk))
+    missing--;
+
+  for (; missing; missing--)
+  {
+    uchar *new_chunk= next_free_chunk(share);
+    if (!new_chunk)
+    {
+      hp_free_chunks(share, *extra);
+      *extra= NULL;
+      DBUG_RETURN(my_errno);
+    }
+    *((uchar**) new_chunk)= NULL;
+    *link= new_chunk;
+    link= (uchar**) new_chunk;
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Replace the packed part of a record with the one prepared by
+  hp_extend_chunks(). The chain of the record is reused, extended with
+  the extra chunks or cut where the new packed part ends.
+*/
+
+void hp_rewrite_chunks(HP_INFO *info, uchar *pos, uchar *extra)
+{
+  HP_SHARE *share= info->s;
+  const uchar *from= info->pack_buff;
+  ulong length= uint4korr(from);
+  uchar *chunk= hp_record_chunks(share, pos);
+
+  for (;;)
+  {
+    ulong chunk_length= MY_MIN(length, HP_CHUNK_DATA_LENGTH);
+    uchar *next= *((uchar**) chunk);
+    memcpy(chunk + sizeof(uchar*), from, chunk_length);
+    from+= chunk_length;
+    length-= chunk_length;
+    if (!length)
+    {
+      DBUG_ASSERT(!extra);
+      *((uchar**) chunk)= NULL;
+      hp_free_chunks(share, next);
+      break;
+    }
+    if (!next)
+    {
+      DBUG_ASSERT(extra);
+      *((uchar**) chunk)= extra;
+      next= extra;
+      extra= NULL;
+    }
+    chunk= next;
+  }
+}
+
+
+/* Give a chain of chunks back to the table */
+
+void hp_free_chunks(HP_SHARE *share, uchar *chunks)
+{
+  while (chunks)
+  {
+    uchar *next= *((uchar**) chunks);
+    *((uchar**) chunks)= share->chunk_del_link;
+    share->chunk_del_link= chunks;
+    chunks= next;
+  }
+}
+
+
+/* Store a record, and its chain of chunks, in the record block */
+
+void hp_store_record(HP_SHARE *share, uchar *pos, const uchar *record,
+                     uchar *chunks)
+{
+  if (!share->columns)
+  {
+    memcpy(pos, record, (size_t) share->reclength);
+    return;
+  }
+  memcpy(pos, record, (size_t) share->fixed_length);
+  memcpy(pos + share->fixed_length, &chunks, sizeof(chunks));
+}
+
+
+/* Get the chain of chunks of a record in the record block */
+
+uchar *hp_record_chunks(HP_SHARE *share, const uchar *pos)
+{
+  uchar *chunks;
+  DBUG_ASSERT(share->columns);
+  memcpy(&chunks, pos + share->fixed_length, sizeof(chunks));
+  return chunks;
+}
+
+
+/*
+  Collect the packed part of a record in info->unpack_buff
+
+  RETURN
+    0  ok
+    #  error
+*/
+
+static int read_chunks(HP_INFO *info, const uchar *pos)
+{
+  const uchar *chunk= hp_record_chunks(info->s, pos);
+  ulong length= uint4korr(chunk + sizeof(uchar*));
+  uchar *to;
+
+  if (alloc_buffer(&info->unpack_buff, &info->unpack_buff_length, length))
+    return my_errno;
+  for (to= info->unpack_buff; chunk; chunk= *((const uchar**) chunk))
+  {
+    ulong chunk_length= MY_MIN(length, HP_CHUNK_DATA_LENGTH);
+    memcpy(to, chunk + sizeof(uchar*), chunk_length);
+    to+= chunk_length;
+    length-= chunk_length;
+  }
+  DBUG_ASSERT(!length);
+  return 0;
+}
+
+
+/*
+  Read a record from the record block
+
+  NOTES
+    BLOB columns point into a buffer of info, which is valid until the
+    next record is read with info.
+
+  RETURN
+    0  ok
+    #  error
+*/
+
+int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos)
+{
+  HP_SHARE *share= info->s;
+
+  if (!share->columns)
+  {
+    memcpy(record, pos, (size_t) share->reclength);
+    return 0;
+  }
+  if (read_chunks(info, pos))
+    return my_errno;
+  memcpy(record, pos, (size_t) share->fixed_length);
+  unpack_record(share, record, info->unpack_buff);
+  return 0;
+}
+
+
+/*
+  Compare a record with a record in the record block
+
+  RETURN
+    0  Records are equal
+    1  Records differ
+    -1 Error
+*/
+
+int hp_packed_cmp(HP_INFO *info, const uchar *record, const uchar *pos)
+{
+  HP_SHARE *share= info->s;
+  const HP_COLUMNDEF *column, *end;
+  uint offset= 0;
+  ulong length;
+
+  /* BLOB columns in the record block don't hold the value */
+  for (column= share->columndef, end= column + share->columns;
+       column < end && column->offset < share->fixed_length; column++)
+  {
+    if (memcmp(record + offset, pos + offset, column->offset - offset))
+      return 1;
+    offset= column->offset + column->length;
+  }
+  if (offset < share->fixed_length &&
+      memcmp(record + offset, pos + offset, share->fixed_length - offset))
+    return 1;
+
+  length= packed_length(share, record);
+  if (alloc_buffer(&info->pack_buff, &info->pack_buff_length, length) ||
+      read_chunks(info, pos))
+    return -1;
+  pack_record(share, info->pack_buff, record, length);
+  return MY_TEST(uint4korr(info->unpack_buff) != length ||
+                 memcmp(info->pack_buff, info->unpack_buff, length));
+}
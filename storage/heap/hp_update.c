@@ -21,7 +21,7 @@
 int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
 {
   HP_KEYDEF *keydef, *end, *p_lastinx;
-  uchar *pos;
+  uchar *pos, *extra_chunks= 0;
   my_bool auto_key_changed= 0;
   HP_SHARE *share= info->s;
   DBUG_ENTER("heap_update");
@@ -31,6 +31,10 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
 
   if (info->opt_flag & READ_CHECK_USED && hp_rectest(info,old))
     DBUG_RETURN(my_errno);				/* Record changed */
+  /* Reuse the chunks of the record, allocating only what it grows by */
+  if (share->columns &&
+      hp_extend_chunks(info, heap_new, pos, &extra_chunks))
+    DBUG_RETURN(my_errno);
   if (--(share->records) < share->blength >> 1) share->blength>>= 1;
   share->changed=1;
 
@@ -47,7 +51,10 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
     }
   }
 
-  memcpy(pos,heap_new,(size_t) share->reclength);
+  if (share->columns)
+    hp_rewrite_chunks(info, pos, extra_chunks);
+  hp_store_record(share, pos, heap_new,
+                  share->columns ? hp_record_chunks(share, pos) : NULL);
   if (++(share->records) == share->blength) share->blength+= share->blength;
 
 #if !defined(DBUG_OFF) && defined(EXTRA_HEAP_DEBUG)
@@ -68,6 +75,7 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
       {
         if (++(share->records) == share->blength)
 	  share->blength+= share->blength;
+        hp_free_chunks(share, extra_chunks);
         DBUG_RETURN(my_errno);
       }
       keydef--;
@@ -85,5 +93,6 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
   }
   if (++(share->records) == share->blength)
     share->blength+= share->blength;
+  hp_free_chunks(share, extra_chunks);
   DBUG_RETURN(my_errno);
 } /* heap_update */
@@ -74,9 +74,12 @@ PageBulk::init()
 			return(DB_OUT_OF_FILE_SPACE);
 		}
 
-		/* Allocate a new page. */
-		new_block = btr_page_alloc(m_index, 0, FSP_UP, m_level,
-					   &alloc_mtr, mtr);
+		/* Allocate a new page. The pages of a level are allocated
+		in ascending key order, so allocating upwards from the
+		previous page of the level lets the segment hand out its
+		extents page by page, and the level is stored contiguously. */
+		new_block = btr_page_alloc(m_index, m_hint_page_no, FSP_UP,
+					   m_level, &alloc_mtr, mtr);
 
 		if (n_reserved > 0) {
 			fil_space_release_free_extents(m_index->space,
@@ -815,9 +818,10 @@ BtrBulk::insert(
 	if (!page_bulk->isSpaceAvailable(rec_size)) {
 		/* Create a sibling page_bulk. */
 		PageBulk*	sibling_page_bulk;
-		sibling_page_bulk = UT_NEW_NOKEY(PageBulk(m_index, m_trx_id,
-							  FIL_NULL, level,
-							  m_flush_observer));
+		sibling_page_bulk = UT_NEW_NOKEY(PageBulk(
+				m_index, m_trx_id, FIL_NULL, level,
+				m_flush_observer,
+				page_bulk->getPageNo() + 1));
 		dberr_t	err = sibling_page_bulk->init();
 		if (err != DB_SUCCESS) {
 			UT_DELETE(sibling_page_bulk);
@@ -841,8 +845,12 @@ BtrBulk::insert(
 
 		/* Important: log_free_check whether we need a checkpoint. */
 		if (page_is_leaf(sibling_page_bulk->getPage())) {
-			/* Check whether trx is interrupted */
-			if (m_flush_observer->check_interrupted()) {
+			/* Check whether trx is interrupted. A merge sort
+			thread must not access the transaction; the ALTER
+			TABLE thread checks it and sets the abort flag. */
+			if (m_aborted != NULL
+			    ? *m_aborted
+			    : m_flush_observer->check_interrupted()) {
 				return(DB_INTERRUPTED);
 			}
 
@@ -1944,7 +1944,7 @@ func_exit:
 
 	if (has_search_latch) {
 
-		rw_lock_s_lock(btr_get_search_latch(index));
+		btr_search_s_lock(index);
 	}
 
 	if (mbr_adj) {
@@ -3009,12 +3009,12 @@ btr_cur_prefetch_siblings(
 	if (left_page_no != FIL_NULL) {
 		buf_read_page_background(
 			page_id_t(block->page.id.space(), left_page_no),
-			block->page.size, false);
+			block->page.size, false, false);
 	}
 	if (right_page_no != FIL_NULL) {
 		buf_read_page_background(
 			page_id_t(block->page.id.space(), right_page_no),
-			block->page.size, false);
+			block->page.size, false, false);
 	}
 	if (left_page_no != FIL_NULL
 	    || right_page_no != FIL_NULL) {
@@ -3896,7 +3896,7 @@ btr_cur_update_in_place(
 			btr_search_update_hash_on_delete(cursor);
 		}
 
-		rw_lock_x_lock(btr_get_search_latch(index));
+		btr_search_x_lock(index);
 	}
 
 	row_upd_rec_in_place(rec, index, offsets, update, page_zip);
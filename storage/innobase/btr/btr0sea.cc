@@ -160,7 +160,7 @@ btr_search_check_free_space_in_heap(dict_index_t* index)
 	if (heap->free_block == NULL) {
 		buf_block_t*	block = buf_block_alloc(NULL);
 
-		rw_lock_x_lock(btr_get_search_latch(index));
+		btr_search_x_lock(index);
 
 		if (btr_search_enabled
 		    && heap->free_block == NULL) {
@@ -213,6 +213,18 @@ btr_search_sys_create(ulint hash_size)
 		btr_search_sys->hash_tables[i]->adaptive = TRUE;
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 	}
+
+	/* Step-3: Allocate per-partition statistics, each in a cache line
+	of its own. */
+	ut_ad(sizeof(btr_search_part_stats_t) == CACHE_LINE_SIZE);
+
+	btr_search_sys->part_stats_unaligned = ut_zalloc(
+		sizeof(btr_search_part_stats_t) * (btr_ahi_parts + 1),
+		mem_key_ahi);
+
+	btr_search_sys->part_stats = static_cast<btr_search_part_stats_t*>(
+		ut_align(btr_search_sys->part_stats_unaligned,
+			 CACHE_LINE_SIZE));
 }
 
 /** Resize hash index hash table.
@@ -268,6 +280,7 @@ btr_search_sys_free()
 	}
 
 	ut_free(btr_search_sys->hash_tables);
+	ut_free(btr_search_sys->part_stats_unaligned);
 	ut_free(btr_search_sys);
 	btr_search_sys = NULL;
 
@@ -428,7 +441,7 @@ btr_search_info_get_ref_count(
 	ut_ad(!rw_lock_own(btr_get_search_latch(index), RW_LOCK_S));
 	ut_ad(!rw_lock_own(btr_get_search_latch(index), RW_LOCK_X));
 
-	rw_lock_s_lock(btr_get_search_latch(index));
+	btr_search_s_lock(index);
 	ret = info->ref_count;
 	rw_lock_s_unlock(btr_get_search_latch(index));
 
@@ -733,7 +746,7 @@ btr_search_info_update_slow(
 		btr_search_n_hash_fail++;
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-		rw_lock_x_lock(btr_get_search_latch(cursor->index));
+		btr_search_x_lock(cursor->index);
 
 		btr_search_update_hash_ref(info, block, cursor);
 
@@ -983,7 +996,7 @@ btr_search_guess_on_hash(
 	cursor->flag = BTR_CUR_HASH;
 
 	if (!has_search_latch) {
-		rw_lock_s_lock(btr_get_search_latch(index));
+		btr_search_s_lock(index);
 
 		if (!btr_search_enabled) {
 			rw_lock_s_unlock(btr_get_search_latch(index));
@@ -1000,8 +1013,12 @@ btr_search_guess_on_hash(
 	rec = (rec_t*) ha_search_and_get_data(
 			btr_get_search_table(index), fold);
 
+	btr_search_part_stats_t*	stats = btr_get_search_stats(index);
+
 	if (rec == NULL) {
 
+		stats->n_misses++;
+
 		if (!has_search_latch) {
 			rw_lock_s_unlock(btr_get_search_latch(index));
 		}
@@ -1023,6 +1040,7 @@ btr_search_guess_on_hash(
 				rw_lock_s_unlock(btr_get_search_latch(index));
 			}
 
+			stats->n_misses++;
 			btr_search_failure(info, cursor);
 
 			return(FALSE);
@@ -1042,6 +1060,7 @@ btr_search_guess_on_hash(
 			btr_leaf_page_release(block, latch_mode, mtr);
 		}
 
+		stats->n_misses++;
 		btr_search_failure(info, cursor);
 
 		return(FALSE);
@@ -1067,6 +1086,7 @@ btr_search_guess_on_hash(
 			btr_leaf_page_release(block, latch_mode, mtr);
 		}
 
+		stats->n_misses++;
 		btr_search_failure(info, cursor);
 
 		return(FALSE);
@@ -1113,6 +1133,7 @@ btr_search_guess_on_hash(
 	meanwhile! Thus it might not be a bug. */
 #endif
 	info->last_hash_succ = TRUE;
+	stats->n_hits++;
 
 #ifdef UNIV_SEARCH_PERF_STAT
 	btr_search_n_succ++;
@@ -1436,7 +1457,7 @@ btr_search_build_page_hash_index(
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_S)
 	      || rw_lock_own(&(block->lock), RW_LOCK_X));
 
-	rw_lock_s_lock(btr_get_search_latch(index));
+	btr_search_s_lock(index);
 
 	if (!btr_search_enabled) {
 		rw_lock_s_unlock(btr_get_search_latch(index));
@@ -1546,7 +1567,7 @@ btr_search_build_page_hash_index(
 
 	btr_search_check_free_space_in_heap(index);
 
-	rw_lock_x_lock(btr_get_search_latch(index));
+	btr_search_x_lock(index);
 
 	if (UNIV_UNLIKELY(!btr_search_enabled)) {
 		goto exit_func;
@@ -1618,7 +1639,7 @@ btr_search_move_or_delete_hash_entries(
 	ut_ad(rw_lock_own(&(block->lock), RW_LOCK_X));
 	ut_ad(rw_lock_own(&(new_block->lock), RW_LOCK_X));
 
-	rw_lock_s_lock(btr_get_search_latch(index));
+	btr_search_s_lock(index);
 
 	ut_a(!new_block->index || new_block->index == index);
 	ut_a(!block->index || block->index == index);
@@ -1704,7 +1725,7 @@ btr_search_update_hash_on_delete(btr_cur_t* cursor)
 		mem_heap_free(heap);
 	}
 
-	rw_lock_x_lock(btr_get_search_latch(index));
+	btr_search_x_lock(index);
 
 	if (block->index) {
 		ut_a(block->index == index);
@@ -1752,7 +1773,7 @@ btr_search_update_hash_node_on_insert(btr_cur_t* cursor)
 	ut_a(cursor->index == index);
 	ut_a(!dict_index_is_ibuf(index));
 
-	rw_lock_x_lock(btr_get_search_latch(index));
+	btr_search_x_lock(index);
 
 	if (!block->index) {
 
@@ -1862,7 +1883,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor)
 	} else {
 		if (left_side) {
 
-			rw_lock_x_lock(btr_get_search_latch(index));
+			btr_search_x_lock(index);
 
 			locked = TRUE;
 
@@ -1880,7 +1901,7 @@ btr_search_update_hash_on_insert(btr_cur_t* cursor)
 
 		if (!locked) {
 
-			rw_lock_x_lock(btr_get_search_latch(index));
+			btr_search_x_lock(index);
 
 			locked = TRUE;
 
@@ -1902,7 +1923,7 @@ check_next_rec:
 		if (!left_side) {
 
 			if (!locked) {
-				rw_lock_x_lock(btr_get_search_latch(index));
+				btr_search_x_lock(index);
 
 				locked = TRUE;
 
@@ -1921,7 +1942,7 @@ check_next_rec:
 
 		if (!locked) {
 
-			rw_lock_x_lock(btr_get_search_latch(index));
+			btr_search_x_lock(index);
 
 			locked = TRUE;
 
@@ -64,6 +64,7 @@ Created 11/5/1995 Heikki Tuuri
 #include "log0recv.h"
 #include "srv0mon.h"
 #include "fsp0sysspace.h"
+#include "buf0rea.h"
 #endif /* !UNIV_INNOCHECKSUM */
 #include "page0zip.h"
 #include "buf0checksum.h"
@@ -4948,6 +4949,7 @@ buf_page_init_low(
 {
 	bpage->flush_type = BUF_FLUSH_LRU;
 	bpage->io_fix = BUF_IO_NONE;
+	bpage->load_read = FALSE;
 	bpage->buf_fix_count = 0;
 	bpage->freed_page_clock = 0;
 	bpage->access_time = 0;
@@ -5565,6 +5567,7 @@ buf_mark_space_corrupt(
 
 	/* Set BUF_IO_NONE before we remove the block from LRU list */
 	buf_page_set_io_fix(bpage, BUF_IO_NONE);
+	buf_read_page_end(bpage);
 
 	if (uncompressed) {
 		rw_lock_x_unlock_gen(
@@ -5815,6 +5818,7 @@ corrupt:
 		ut_ad(buf_pool->n_pend_reads > 0);
 		buf_pool->n_pend_reads--;
 		buf_pool->stat.n_pages_read++;
+		buf_read_page_end(bpage);
 
 		if (uncompressed) {
 			rw_lock_x_unlock_gen(&((buf_block_t*) bpage)->lock,
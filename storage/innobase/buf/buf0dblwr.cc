@@ -74,6 +74,16 @@ buf_dblwr_page_inside(
 	return(FALSE);
 }
 
+/** Get the doublewrite batch segment used by a buffer pool instance.
+@param[in]	instance_no	buffer pool instance number
+@return batch segment */
+static
+buf_dblwr_seg_t*
+buf_dblwr_get_seg(ulint instance_no)
+{
+	return(&buf_dblwr->segs[instance_no % buf_dblwr->n_segs]);
+}
+
 /****************************************************************//**
 Calls buf_page_get() on the TRX_SYS_PAGE and returns a pointer to the
 doublewrite buffer within it.
@@ -139,11 +149,38 @@ buf_dblwr_init(
 
 	mutex_create(LATCH_ID_BUF_DBLWR, &buf_dblwr->mutex);
 
-	buf_dblwr->b_event = os_event_create("dblwr_batch_event");
 	buf_dblwr->s_event = os_event_create("dblwr_single_event");
-	buf_dblwr->first_free = 0;
 	buf_dblwr->s_reserved = 0;
-	buf_dblwr->b_reserved = 0;
+
+	/* Divide the batch slots between the buffer pool instances so
+	that their flushes do not have to wait for each other, but keep
+	at least BUF_DBLWR_MIN_SEG_SLOTS slots in each segment. */
+	buf_dblwr->n_segs = ut_max(
+		ut_min(srv_buf_pool_instances,
+		       srv_doublewrite_batch_size / BUF_DBLWR_MIN_SEG_SLOTS),
+		ulint(1));
+
+	buf_dblwr->segs = static_cast<buf_dblwr_seg_t*>(
+		ut_zalloc_nokey(buf_dblwr->n_segs * sizeof(buf_dblwr_seg_t)));
+
+	/* Spread the remainder over the first segments. */
+	ulint	seg_size = srv_doublewrite_batch_size / buf_dblwr->n_segs;
+	ulint	n_larger = srv_doublewrite_batch_size % buf_dblwr->n_segs;
+	ulint	first_slot = 0;
+
+	for (ulint i = 0; i < buf_dblwr->n_segs; ++i) {
+		buf_dblwr_seg_t*	seg = &buf_dblwr->segs[i];
+
+		mutex_create(LATCH_ID_BUF_DBLWR, &seg->mutex);
+
+		seg->b_event = os_event_create("dblwr_batch_event");
+		seg->first_slot = first_slot;
+		seg->n_slots = seg_size + (i < n_larger ? 1 : 0);
+
+		first_slot += seg->n_slots;
+	}
+
+	ut_ad(first_slot == srv_doublewrite_batch_size);
 
 	buf_dblwr->block1 = mach_read_from_4(
 		doublewrite + TRX_SYS_DOUBLEWRITE_BLOCK1);
@@ -698,9 +735,19 @@ buf_dblwr_free(void)
 	/* Free the double write data structures. */
 	ut_a(buf_dblwr != NULL);
 	ut_ad(buf_dblwr->s_reserved == 0);
-	ut_ad(buf_dblwr->b_reserved == 0);
 
-	os_event_destroy(buf_dblwr->b_event);
+	for (ulint i = 0; i < buf_dblwr->n_segs; ++i) {
+		buf_dblwr_seg_t*	seg = &buf_dblwr->segs[i];
+
+		ut_ad(seg->b_reserved == 0);
+
+		os_event_destroy(seg->b_event);
+		mutex_free(&seg->mutex);
+	}
+
+	ut_free(buf_dblwr->segs);
+	buf_dblwr->segs = NULL;
+
 	os_event_destroy(buf_dblwr->s_event);
 	ut_free(buf_dblwr->write_buf_unaligned);
 	buf_dblwr->write_buf_unaligned = NULL;
@@ -734,30 +781,34 @@ buf_dblwr_update(
 
 	switch (flush_type) {
 	case BUF_FLUSH_LIST:
-	case BUF_FLUSH_LRU:
-		mutex_enter(&buf_dblwr->mutex);
+	case BUF_FLUSH_LRU: {
+		buf_dblwr_seg_t*	seg = buf_dblwr_get_seg(
+			buf_pool_from_bpage(bpage)->instance_no);
+
+		mutex_enter(&seg->mutex);
 
-		ut_ad(buf_dblwr->batch_running);
-		ut_ad(buf_dblwr->b_reserved > 0);
-		ut_ad(buf_dblwr->b_reserved <= buf_dblwr->first_free);
+		ut_ad(seg->batch_running);
+		ut_ad(seg->b_reserved > 0);
+		ut_ad(seg->b_reserved <= seg->first_free);
 
-		buf_dblwr->b_reserved--;
+		seg->b_reserved--;
 
-		if (buf_dblwr->b_reserved == 0) {
-			mutex_exit(&buf_dblwr->mutex);
+		if (seg->b_reserved == 0) {
+			mutex_exit(&seg->mutex);
 			/* This will finish the batch. Sync data files
 			to the disk. */
 			fil_flush_file_spaces(FIL_TYPE_TABLESPACE);
-			mutex_enter(&buf_dblwr->mutex);
+			mutex_enter(&seg->mutex);
 
 			/* We can now reuse the doublewrite memory buffer: */
-			buf_dblwr->first_free = 0;
-			buf_dblwr->batch_running = false;
-			os_event_set(buf_dblwr->b_event);
+			seg->first_free = 0;
+			seg->batch_running = false;
+			os_event_set(seg->b_event);
 		}
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&seg->mutex);
 		break;
+	}
 	case BUF_FLUSH_SINGLE_PAGE:
 		{
 			const ulint size = 2 * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE;
@@ -928,19 +979,58 @@ buf_dblwr_write_block_to_datafile(
 	}
 }
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+/** Writes consecutive slots of the doublewrite memory buffer to the
+doublewrite blocks in the system tablespace, using synchronous IO.
+@param[in]	first	first slot to write
+@param[in]	n	number of slots to write */
+static
 void
-buf_dblwr_flush_buffered_writes(void)
-/*=================================*/
+buf_dblwr_write_slots(
+	ulint	first,
+	ulint	n)
+{
+	ut_ad(first + n <= 2 * TRX_SYS_DOUBLEWRITE_BLOCK_SIZE);
+
+	if (first < TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
+		/* Write out the part in the first block */
+		ulint	n1 = ut_min(n, TRX_SYS_DOUBLEWRITE_BLOCK_SIZE - first);
+
+		fil_io(IORequestWrite, true,
+		       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1 + first),
+		       univ_page_size, 0, n1 * UNIV_PAGE_SIZE,
+		       (void*) (buf_dblwr->write_buf + first * UNIV_PAGE_SIZE),
+		       NULL);
+
+		first += n1;
+		n -= n1;
+	}
+
+	if (n == 0) {
+		/* No unwritten pages in the second block. */
+		return;
+	}
+
+	/* Write out the part in the second block */
+	fil_io(IORequestWrite, true,
+	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block2 + first
+			 - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE),
+	       univ_page_size, 0, n * UNIV_PAGE_SIZE,
+	       (void*) (buf_dblwr->write_buf + first * UNIV_PAGE_SIZE),
+	       NULL);
+}
+
+/** Flushes possible buffered writes from the doublewrite memory buffer
+segment of a buffer pool instance to disk, and also wakes up the aio thread
+if simulated aio is used. It is very important to call this function after
+a batch of writes has been posted, and also when we may have to wait for a
+page latch! Otherwise a deadlock of threads can occur.
+@param[in]	instance_no	buffer pool instance whose doublewrite
+				batch segment is to be flushed */
+void
+buf_dblwr_flush_buffered_writes(ulint instance_no)
 {
 	byte*		write_buf;
 	ulint		first_free;
-	ulint		len;
 
 	if (!srv_use_doublewrite_buf || buf_dblwr == NULL) {
 		/* Sync the writes to the disk. */
@@ -950,16 +1040,18 @@ buf_dblwr_flush_buffered_writes(void)
 
 	ut_ad(!srv_read_only_mode);
 
+	buf_dblwr_seg_t*	seg = buf_dblwr_get_seg(instance_no);
+
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&seg->mutex);
 
 	/* Write first to doublewrite buffer blocks. We use synchronous
 	aio and thus know that file write has been completed when the
 	control returns. */
 
-	if (buf_dblwr->first_free == 0) {
+	if (seg->first_free == 0) {
 
-		mutex_exit(&buf_dblwr->mutex);
+		mutex_exit(&seg->mutex);
 
 		/* Wake possible simulated aio thread as there could be
 		system temporary tablespace pages active for flushing.
@@ -970,39 +1062,41 @@ try_again:
 		return;
 	}
 
-	if (buf_dblwr->batch_running) {
+	if (seg->batch_running) {
 		/* Another thread is running the batch right now. Wait
 		for it to finish. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(seg->b_event);
+		mutex_exit(&seg->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(seg->b_event, sig_count);
 		goto try_again;
 	}
 
-	ut_a(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
+	ut_a(!seg->batch_running);
+	ut_ad(seg->first_free == seg->b_reserved);
 
-	/* Disallow anyone else to post to doublewrite buffer or to
-	start another batch of flushing. */
-	buf_dblwr->batch_running = true;
-	first_free = buf_dblwr->first_free;
+	/* Disallow anyone else to post to this segment or to start
+	another batch of flushing from it. */
+	seg->batch_running = true;
+	first_free = seg->first_free;
 
 	/* Now safe to release the mutex. Note that though no other
-	thread is allowed to post to the doublewrite batch flushing
-	but any threads working on single page flushes are allowed
+	thread is allowed to post to this segment but any threads
+	working on single page flushes or on other segments are allowed
 	to proceed. */
-	mutex_exit(&buf_dblwr->mutex);
+	mutex_exit(&seg->mutex);
 
-	write_buf = buf_dblwr->write_buf;
+	write_buf = buf_dblwr->write_buf + seg->first_slot * UNIV_PAGE_SIZE;
+
+	buf_page_t**	block_arr = buf_dblwr->buf_block_arr + seg->first_slot;
 
 	for (ulint len2 = 0, i = 0;
-	     i < buf_dblwr->first_free;
+	     i < first_free;
 	     len2 += UNIV_PAGE_SIZE, i++) {
 
 		const buf_block_t*	block;
 
-		block = (buf_block_t*) buf_dblwr->buf_block_arr[i];
+		block = (buf_block_t*) block_arr[i];
 
 		if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE
 		    || block->page.zip.data) {
@@ -1020,33 +1114,10 @@ try_again:
 		buf_dblwr_check_page_lsn(write_buf + len2);
 	}
 
-	/* Write out the first block of the doublewrite buffer */
-	len = ut_min(TRX_SYS_DOUBLEWRITE_BLOCK_SIZE,
-		     buf_dblwr->first_free) * UNIV_PAGE_SIZE;
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block1), univ_page_size,
-	       0, len, (void*) write_buf, NULL);
-
-	if (buf_dblwr->first_free <= TRX_SYS_DOUBLEWRITE_BLOCK_SIZE) {
-		/* No unwritten pages in the second block. */
-		goto flush;
-	}
-
-	/* Write out the second block of the doublewrite buffer. */
-	len = (buf_dblwr->first_free - TRX_SYS_DOUBLEWRITE_BLOCK_SIZE)
-	       * UNIV_PAGE_SIZE;
+	buf_dblwr_write_slots(seg->first_slot, first_free);
 
-	write_buf = buf_dblwr->write_buf
-		    + TRX_SYS_DOUBLEWRITE_BLOCK_SIZE * UNIV_PAGE_SIZE;
-
-	fil_io(IORequestWrite, true,
-	       page_id_t(TRX_SYS_SPACE, buf_dblwr->block2), univ_page_size,
-	       0, len, (void*) write_buf, NULL);
-
-flush:
 	/* increment the doublewrite flushed pages counter */
-	srv_stats.dblwr_pages_written.add(buf_dblwr->first_free);
+	srv_stats.dblwr_pages_written.add(first_free);
 	srv_stats.dblwr_writes.inc();
 
 	/* Now flush the doublewrite buffer data to disk */
@@ -1056,21 +1127,17 @@ flush:
 	and in recovery we will find them in the doublewrite buffer
 	blocks. Next do the writes to the intended positions. */
 
-	/* Up to this point first_free and buf_dblwr->first_free are
-	same because we have set the buf_dblwr->batch_running flag
-	disallowing any other thread to post any request but we
-	can't safely access buf_dblwr->first_free in the loop below.
+	/* We can't safely access seg->first_free in the loop below.
 	This is so because it is possible that after we are done with
 	the last iteration and before we terminate the loop, the batch
 	gets finished in the IO helper thread and another thread posts
-	a new batch setting buf_dblwr->first_free to a higher value.
-	If this happens and we are using buf_dblwr->first_free in the
+	a new batch setting seg->first_free to a higher value.
+	If this happens and we are using seg->first_free in the
 	loop termination condition then we'll end up dispatching
 	the same block twice from two different threads. */
-	ut_ad(first_free == buf_dblwr->first_free);
+	ut_ad(first_free == seg->first_free);
 	for (ulint i = 0; i < first_free; i++) {
-		buf_dblwr_write_block_to_datafile(
-			buf_dblwr->buf_block_arr[i], false);
+		buf_dblwr_write_block_to_datafile(block_arr[i], false);
 	}
 
 	/* Wake possible simulated aio thread to actually post the
@@ -1091,12 +1158,16 @@ buf_dblwr_add_to_batch(
 {
 	ut_a(buf_page_in_file(bpage));
 
+	ulint			instance_no
+		= buf_pool_from_bpage(bpage)->instance_no;
+	buf_dblwr_seg_t*	seg = buf_dblwr_get_seg(instance_no);
+
 try_again:
-	mutex_enter(&buf_dblwr->mutex);
+	mutex_enter(&seg->mutex);
 
-	ut_a(buf_dblwr->first_free <= srv_doublewrite_batch_size);
+	ut_a(seg->first_free <= seg->n_slots);
 
-	if (buf_dblwr->batch_running) {
+	if (seg->batch_running) {
 
 		/* This not nearly as bad as it looks. There is only
 		page_cleaner thread which does background flushing
@@ -1104,23 +1175,24 @@ try_again:
 		point. The only exception is when a user thread is
 		forced to do a flush batch because of a sync
 		checkpoint. */
-		int64_t	sig_count = os_event_reset(buf_dblwr->b_event);
-		mutex_exit(&buf_dblwr->mutex);
+		int64_t	sig_count = os_event_reset(seg->b_event);
+		mutex_exit(&seg->mutex);
 
-		os_event_wait_low(buf_dblwr->b_event, sig_count);
+		os_event_wait_low(seg->b_event, sig_count);
 		goto try_again;
 	}
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (seg->first_free == seg->n_slots) {
+		mutex_exit(&seg->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(instance_no);
 
 		goto try_again;
 	}
 
-	byte*	p = buf_dblwr->write_buf
-		+ univ_page_size.physical() * buf_dblwr->first_free;
+	ulint	slot = seg->first_slot + seg->first_free;
+
+	byte*	p = buf_dblwr->write_buf + univ_page_size.physical() * slot;
 
 	if (bpage->size.is_compressed()) {
 		UNIV_MEM_ASSERT_RW(bpage->zip.data, bpage->size.physical());
@@ -1139,24 +1211,24 @@ try_again:
 		memcpy(p, ((buf_block_t*) bpage)->frame, bpage->size.logical());
 	}
 
-	buf_dblwr->buf_block_arr[buf_dblwr->first_free] = bpage;
+	buf_dblwr->buf_block_arr[slot] = bpage;
 
-	buf_dblwr->first_free++;
-	buf_dblwr->b_reserved++;
+	seg->first_free++;
+	seg->b_reserved++;
 
-	ut_ad(!buf_dblwr->batch_running);
-	ut_ad(buf_dblwr->first_free == buf_dblwr->b_reserved);
-	ut_ad(buf_dblwr->b_reserved <= srv_doublewrite_batch_size);
+	ut_ad(!seg->batch_running);
+	ut_ad(seg->first_free == seg->b_reserved);
+	ut_ad(seg->b_reserved <= seg->n_slots);
 
-	if (buf_dblwr->first_free == srv_doublewrite_batch_size) {
-		mutex_exit(&(buf_dblwr->mutex));
+	if (seg->first_free == seg->n_slots) {
+		mutex_exit(&seg->mutex);
 
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(instance_no);
 
 		return;
 	}
 
-	mutex_exit(&(buf_dblwr->mutex));
+	mutex_exit(&seg->mutex);
 }
 
 /********************************************************************//**
@@ -33,6 +33,7 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h"
 #include "buf0dump.h"
+#include "buf0rea.h"
 #include "dict0dict.h"
 #include "os0file.h"
 #include "os0thread.h"
@@ -599,11 +600,23 @@ buf_load()
 			continue;
 		}
 
+		/* Post asynchronous reads, so that the io handler threads
+		can work on many pages at once instead of waiting for the
+		pages one by one. */
 		buf_read_page_background(
 			page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])),
-			page_size, true);
+			page_size, false, true);
+
+		/* dump[] is sorted, so adjacent pages of a tablespace are
+		posted one after the other. Let the simulated aio handler
+		threads merge them into one request by waking them only
+		at the end of each run of adjacent pages. */
+		if (i % 64 == 63
+		    || i + 1 == dump_n
+		    || BUF_DUMP_SPACE(dump[i + 1]) != this_space_id
+		    || BUF_DUMP_PAGE(dump[i + 1])
+		    != BUF_DUMP_PAGE(dump[i]) + 1) {
 
-		if (i % 64 == 63) {
 			os_aio_simulated_wake_handler_threads();
 		}
 
@@ -650,6 +663,16 @@ buf_load()
 
 	ut_free(dump);
 
+	/* Wait for the posted reads to complete before reporting that
+	the load has completed. Reads requested by other threads are not
+	waited for. */
+	os_aio_simulated_wake_handler_threads();
+
+	while (buf_load_n_pending_reads > 0 && !SHUTTING_DOWN()) {
+
+		os_thread_sleep(10000);
+	}
+
 	ut_sprintf_timestamp(now);
 
 	buf_load_status(STATUS_INFO,
@@ -1190,7 +1190,8 @@ buf_flush_page(
 				/* avoiding deadlock possibility involves
 				doublewrite buffer, should flush it, because
 				it might hold the another block->lock. */
-				buf_dblwr_flush_buffered_writes();
+				buf_dblwr_flush_buffered_writes(
+					buf_pool->instance_no);
 			} else {
 				buf_dblwr_sync_datafiles();
 			}
@@ -1618,9 +1619,13 @@ buf_flush_LRU_list_batch(
 				 - UT_LIST_GET_LEN(buf_pool->withdraw);
 	}
 
+	ulint		free_target = ut_max(
+		static_cast<ulint>(srv_LRU_scan_depth),
+		buf_pool->LRU_free_target);
+
 	for (bpage = UT_LIST_GET_LAST(buf_pool->LRU);
 	     bpage != NULL && count + evict_count < max
-	     && free_len < srv_LRU_scan_depth + withdraw_depth
+	     && free_len < free_target + withdraw_depth
 	     && lru_len > BUF_LRU_MIN_LEN;
 	     ++scanned,
 	     bpage = buf_pool->lru_hp.get()) {
@@ -1937,7 +1942,7 @@ buf_flush_end(
 	buf_pool_mutex_exit(buf_pool);
 
 	if (!srv_read_only_mode) {
-		buf_dblwr_flush_buffered_writes();
+		buf_dblwr_flush_buffered_writes(buf_pool->instance_no);
 	} else {
 		os_aio_simulated_wake_handler_threads();
 	}
@@ -2236,12 +2241,59 @@ buf_flush_single_page_from_LRU(
 	return(freed);
 }
 
+/** Computes how many free blocks the LRU flush of a buffer pool instance
+should keep on the free list. The target follows the rate at which blocks
+were taken for page reads and page creations since the previous call, so
+that the free list lasts until the next page cleaner iteration and user
+threads do not have to flush pages from the LRU list themselves. It is
+never below innodb_LRU_scan_depth and never above 1% of the instance.
+@param[in,out]	buf_pool	buffer pool instance
+@return number of free blocks to aim for */
+static
+ulint
+buf_flush_LRU_free_target(
+	buf_pool_t*	buf_pool)
+{
+	ut_ad(buf_pool_mutex_own(buf_pool));
+
+	ulint	now = ut_time_ms();
+	ulint	n_used = buf_pool->stat.n_pages_read
+		+ buf_pool->stat.n_pages_created;
+	ulint	target = srv_LRU_scan_depth;
+
+	if (buf_pool->LRU_free_last_time != 0
+	    && now > buf_pool->LRU_free_last_time
+	    && n_used >= buf_pool->LRU_free_last_used) {
+
+		/* Blocks consumed per second, which is the interval
+		of the page cleaner. Average with the previous target to
+		smooth out bursts. */
+		ulint	demand = (n_used - buf_pool->LRU_free_last_used)
+			* 1000 / (now - buf_pool->LRU_free_last_time);
+
+		demand = (demand + buf_pool->LRU_free_target) / 2;
+
+		ulint	cap = ut_max(target, buf_pool->curr_size / 100);
+
+		target = ut_min(ut_max(demand, target), cap);
+	}
+
+	buf_pool->LRU_free_last_time = now;
+	buf_pool->LRU_free_last_used = n_used;
+	buf_pool->LRU_free_target = target;
+
+	MONITOR_SET(MONITOR_LRU_FREE_TARGET, target);
+
+	return(target);
+}
+
 /**
 Clears up tail of the LRU list of a given buffer pool instance:
 * Put replaceable pages at the tail of LRU to the free list
 * Flush dirty pages at the tail of LRU to the disk
 The depth to which we scan each buffer pool is controlled by dynamic
-config parameter innodb_LRU_scan_depth.
+config parameter innodb_LRU_scan_depth, raised when pages have recently
+been consumed faster, see buf_flush_LRU_free_target().
 @param buf_pool buffer pool instance
 @return total pages flushed */
 static
@@ -2249,7 +2301,7 @@ ulint
 buf_flush_LRU_list(
 	buf_pool_t*	buf_pool)
 {
-	ulint	scan_depth, withdraw_depth;
+	ulint	scan_depth, withdraw_depth, free_target;
 	ulint	n_flushed = 0;
 
 	ut_ad(buf_pool);
@@ -2257,6 +2309,7 @@ buf_flush_LRU_list(
 	/* srv_LRU_scan_depth can be arbitrarily large value.
 	We cap it with current LRU size. */
 	buf_pool_mutex_enter(buf_pool);
+	free_target = buf_flush_LRU_free_target(buf_pool);
 	scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
 	if (buf_pool->curr_size < buf_pool->old_size
 	    && buf_pool->withdraw_target > 0) {
@@ -2267,11 +2320,10 @@ buf_flush_LRU_list(
 	}
 	buf_pool_mutex_exit(buf_pool);
 
-	if (withdraw_depth > srv_LRU_scan_depth) {
+	if (withdraw_depth > free_target) {
 		scan_depth = ut_min(withdraw_depth, scan_depth);
 	} else {
-		scan_depth = ut_min(static_cast<ulint>(srv_LRU_scan_depth),
-				    scan_depth);
+		scan_depth = ut_min(free_target, scan_depth);
 	}
 
 	/* Currently one of page_cleaners is the only thread
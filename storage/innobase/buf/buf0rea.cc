@@ -45,6 +45,10 @@ a random read-ahead */
 #define BUF_READ_AHEAD_RANDOM_THRESHOLD(b)	\
 				(5 + BUF_READ_AHEAD_AREA(b) / 8)
 
+/** Number of page reads requested by buf_load() that have not
+completed yet */
+ulint	buf_load_n_pending_reads;
+
 /** If there are buf_pool->curr_size per the number below pending reads, then
 read-ahead is not done: this is to prevent flooding the buffer pool with
 i/o-fixed buffer blocks */
@@ -71,6 +75,7 @@ buf_read_page_handle_error(
 
 	/* Set BUF_IO_NONE before we remove the block from LRU list */
 	buf_page_set_io_fix(bpage, BUF_IO_NONE);
+	buf_read_page_end(bpage);
 
 	if (uncompressed) {
 		rw_lock_x_unlock_gen(
@@ -102,6 +107,8 @@ flag is cleared and the x-lock released by an i/o-handler thread.
 @param[in] sync		true if synchronous aio is desired
 @param[in] type		IO type, SIMULATED, IGNORE_MISSING
 @param[in] mode		BUF_READ_IBUF_PAGES_ONLY, ...,
+			BUF_READ_LOAD_PAGE to count the read in
+			buf_load_n_pending_reads
 @param[in] page_id	page id
 @param[in] unzip	true=request uncompressed page
 @return 1 if a read request was queued, 0 if the page already resided
@@ -146,13 +153,27 @@ buf_read_page_low(
 	or is being dropped; if we succeed in initing the page in the buffer
 	pool for read, then DISCARD cannot proceed until the read has
 	completed */
-	bpage = buf_page_init_for_read(err, mode, page_id, page_size, unzip);
+	bpage = buf_page_init_for_read(
+		err, mode == BUF_READ_LOAD_PAGE ? BUF_READ_ANY_PAGE : mode,
+		page_id, page_size, unzip);
 
 	if (bpage == NULL) {
 
 		return(0);
 	}
 
+	if (mode == BUF_READ_LOAD_PAGE) {
+		/* Count the read before it is posted, so that its
+		completion cannot precede the increment. */
+		BPageMutex*	block_mutex = buf_page_get_mutex(bpage);
+
+		mutex_enter(block_mutex);
+		bpage->load_read = TRUE;
+		mutex_exit(block_mutex);
+
+		os_atomic_increment_ulint(&buf_load_n_pending_reads, 1);
+	}
+
 	DBUG_PRINT("ib_buf", ("read page %u:%u size=%u unzip=%u,%s",
 			      (unsigned) page_id.space(),
 			      (unsigned) page_id.page_no(),
@@ -425,12 +446,15 @@ released by the i/o-handler thread.
 @param[in]	page_id		page id
 @param[in]	page_size	page size
 @param[in]	sync		true if synchronous aio is desired
+@param[in]	load		true if buf_load() requests the read; it is
+then counted in buf_load_n_pending_reads until it completes
 @return TRUE if page has been read in, FALSE in case of failure */
 ibool
 buf_read_page_background(
 	const page_id_t&	page_id,
 	const page_size_t&	page_size,
-	bool			sync)
+	bool			sync,
+	bool			load)
 {
 	ulint		count;
 	dberr_t		err;
@@ -438,7 +462,7 @@ buf_read_page_background(
 	count = buf_read_page_low(
 		&err, sync,
 		IORequest::DO_NOT_WAKE | IORequest::IGNORE_MISSING,
-		BUF_READ_ANY_PAGE,
+		load ? BUF_READ_LOAD_PAGE : BUF_READ_ANY_PAGE,
 		page_id, page_size, false);
 
 	srv_stats.buf_pool_reads.add(count);
@@ -453,6 +477,24 @@ buf_read_page_background(
 	return(count > 0);
 }
 
+/** Note that the read of a page has ended, successfully or not. If the
+read was requested by buf_load(), it is no longer counted in
+buf_load_n_pending_reads. The caller must hold the block mutex.
+@param[in,out]	bpage	page whose read has ended */
+void
+buf_read_page_end(
+	buf_page_t*	bpage)
+{
+	ut_ad(mutex_own(buf_page_get_mutex(bpage)));
+
+	if (bpage->load_read) {
+		bpage->load_read = FALSE;
+
+		ut_ad(buf_load_n_pending_reads > 0);
+		os_atomic_decrement_ulint(&buf_load_n_pending_reads, 1);
+	}
+}
+
 /** Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
 Does not read any page if the read-ahead mechanism is not activated. Note
@@ -2846,6 +2846,27 @@ undo_size_ok:
 		dict_sys->size += mem_heap_get_size(new_index->heap);
 	}
 
+	if (!dict_index_is_spatial(new_index)
+	    && !dict_index_is_ibuf(new_index)) {
+
+		for (i = 0; i < new_index->n_uniq
+		     && i < CMP_MEMCMP_KEY_MAX_FIELDS; i++) {
+
+			const dict_field_t*	field;
+			field = dict_index_get_nth_field(new_index, i);
+
+			if (!field->fixed_len
+			    || field->prefix_len
+			    || !(field->col->prtype & DATA_NOT_NULL)
+			    || !cmp_type_is_memcmp(field->col->mtype,
+						   field->col->prtype)) {
+				break;
+			}
+		}
+
+		new_index->rec_cache.n_memcmp_fields = i;
+	}
+
 	/* Check if key part of the index is unique. */
 	if (dict_table_is_intrinsic(table)) {
 
@@ -1887,6 +1887,10 @@ dict_stats_analyze_index(
 
 	DEBUG_PRINTF("  %s(index=%s)\n", __func__, index->name());
 
+	/* Changes from now on are not necessarily seen by the
+	analysis below. */
+	index->stat_modified_counter = 0;
+
 	dict_stats_empty_index(index);
 
 	mtr_start(&mtr);
@@ -2160,18 +2164,115 @@ found_level:
 	DBUG_VOID_RETURN;
 }
 
+/** Allocator type used for index_vec_t. */
+typedef ut_allocator<dict_index_t*>	index_vec_t_allocator;
+
+/** Indexes to be analyzed by dict_stats_update_persistent(). */
+typedef std::vector<dict_index_t*, index_vec_t_allocator>	index_vec_t;
+
+/** Indexes of a table that are analyzed in parallel by the thread
+executing dict_stats_update_persistent() and a number of
+dict_stats_analyze_thread(). */
+struct dict_stats_analyze_t {
+	const dict_table_t*	table;	/*!< table whose indexes are
+					analyzed */
+	dict_index_t* const*	indexes;/*!< indexes to analyze */
+	ulint			n_indexes;/*!< size of indexes[] */
+	volatile ulint		next;	/*!< number of indexes that have
+					been taken by the threads; may
+					exceed n_indexes */
+	OSThreadGroup		threads;/*!< the analyzing threads */
+};
+
+/** Analyze the indexes of a table until there are none left.
+@param[in,out]	analyze	indexes being analyzed */
+static
+void
+dict_stats_analyze_indexes(
+	dict_stats_analyze_t*	analyze)
+{
+	for (;;) {
+		ulint	i = os_atomic_increment_ulint(&analyze->next, 1) - 1;
+
+		if (i >= analyze->n_indexes) {
+			break;
+		}
+
+		if (!(analyze->table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
+			dict_stats_analyze_index(analyze->indexes[i]);
+		}
+	}
+}
+
+/** Thread that analyzes indexes of a table for
+dict_stats_update_persistent().
+@param[in,out]	arg	dict_stats_analyze_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(dict_stats_analyze_thread)(
+	void*	arg)
+{
+	dict_stats_analyze_t*	analyze
+		= static_cast<dict_stats_analyze_t*>(arg);
+
+	dict_stats_analyze_indexes(analyze);
+
+	analyze->threads.exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Analyze indexes of a table, using up to srv_stats_pll_degree threads.
+@param[in]	table	table whose indexes are analyzed
+@param[in]	indexes	indexes to analyze */
+static
+void
+dict_stats_analyze_indexes(
+	const dict_table_t*	table,
+	const index_vec_t&	indexes)
+{
+	dict_stats_analyze_t	analyze;
+
+	analyze.table = table;
+	analyze.indexes = &indexes[0];
+	analyze.n_indexes = indexes.size();
+	analyze.next = 0;
+
+	ulint	n_threads = std::min(
+		analyze.n_indexes, ulint(srv_stats_pll_degree)) - 1;
+
+	for (ulint i = 0; i < n_threads; i++) {
+		if (!analyze.threads.start(dict_stats_analyze_thread,
+					   &analyze)) {
+			break;
+		}
+	}
+
+	/* This thread takes part in the analysis as well. */
+	dict_stats_analyze_indexes(&analyze);
+
+	analyze.threads.join();
+}
+
 /*********************************************************************//**
 Calculates new estimates for table and index statistics. This function
 is relatively slow and is used to calculate persistent statistics that
-will be saved on disk.
+will be saved on disk. The indexes are analyzed in parallel, see
+srv_stats_pll_degree.
 @return DB_SUCCESS or error code */
 static
 dberr_t
 dict_stats_update_persistent(
 /*=========================*/
-	dict_table_t*	table)		/*!< in/out: table */
+	dict_table_t*	table,		/*!< in/out: table */
+	bool		only_changed)	/*!< in: whether to skip the
+					secondary indexes that have not
+					been modified since they were last
+					analyzed */
 {
 	dict_index_t*	index;
+	index_vec_t	indexes;
 
 	DEBUG_PRINTF("%s(table=%s)\n", __func__, table->name);
 
@@ -2194,18 +2295,14 @@ dict_stats_update_persistent(
 
 	ut_ad(!dict_index_is_ibuf(index));
 
-	dict_stats_analyze_index(index);
-
-	ulint	n_unique = dict_index_get_n_unique(index);
-
-	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+	/* The statistics of indexes that have not been analyzed yet
+	cannot be kept. */
+	only_changed = only_changed && table->stat_initialized;
 
-	table->stat_clustered_index_size = index->stat_index_size;
+	indexes.push_back(index);
 
 	/* analyze other indexes from the table, if any */
 
-	table->stat_sum_of_other_index_sizes = 0;
-
 	for (index = dict_table_get_next_index(index);
 	     index != NULL;
 	     index = dict_table_get_next_index(index)) {
@@ -2216,6 +2313,13 @@ dict_stats_update_persistent(
 			continue;
 		}
 
+		if (only_changed
+		    && index->stat_modified_counter == 0
+		    && !dict_stats_should_ignore_index(index)) {
+			/* Keep the current statistics. */
+			continue;
+		}
+
 		dict_stats_empty_index(index);
 
 		if (dict_stats_should_ignore_index(index)) {
@@ -2223,7 +2327,29 @@ dict_stats_update_persistent(
 		}
 
 		if (!(table->stats_bg_flag & BG_STAT_SHOULD_QUIT)) {
-			dict_stats_analyze_index(index);
+			indexes.push_back(index);
+		}
+	}
+
+	dict_stats_analyze_indexes(table, indexes);
+
+	index = dict_table_get_first_index(table);
+
+	ulint	n_unique = dict_index_get_n_unique(index);
+
+	table->stat_n_rows = index->stat_n_diff_key_vals[n_unique - 1];
+
+	table->stat_clustered_index_size = index->stat_index_size;
+
+	table->stat_sum_of_other_index_sizes = 0;
+
+	for (index = dict_table_get_next_index(index);
+	     index != NULL;
+	     index = dict_table_get_next_index(index)) {
+
+		if (index->type & DICT_FTS || dict_index_is_spatial(index)
+		    || dict_stats_should_ignore_index(index)) {
+			continue;
 		}
 
 		table->stat_sum_of_other_index_sizes
@@ -3067,6 +3193,7 @@ dict_stats_update(
 
 	switch (stats_upd_option) {
 	case DICT_STATS_RECALC_PERSISTENT:
+	case DICT_STATS_RECALC_PERSISTENT_CHANGED:
 
 		if (srv_read_only_mode) {
 			goto transient;
@@ -3090,7 +3217,9 @@ dict_stats_update(
 
 			dberr_t	err;
 
-			err = dict_stats_update_persistent(table);
+			err = dict_stats_update_persistent(
+				table, stats_upd_option
+				== DICT_STATS_RECALC_PERSISTENT_CHANGED);
 
 			if (err != DB_SUCCESS) {
 				return(err);
@@ -6657,6 +6657,7 @@ fil_set_compression(
 
 		switch (compression.m_type) {
 		case Compression::LZ4:
+		case Compression::LZ4HC:
 		case Compression::NONE:
 		case Compression::ZLIB:
 			break;
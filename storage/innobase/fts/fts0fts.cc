@@ -67,6 +67,13 @@ ulong	fts_max_total_cache_size;
 a configurable variable */
 ulong	fts_result_cache_limit;
 
+/** Maximum size of the decoded posting lists cached for each table */
+ulong	fts_posting_cache_size;
+
+/** Number of threads that read the posting lists of the terms of
+a query */
+ulong	fts_query_pll_degree;
+
 /** Variable specifying the maximum FTS max token size */
 ulong	fts_max_token_size;
 
@@ -583,6 +590,30 @@ fts_cache_init(
 	}
 }
 
+/** Compare two posting lists in fts_cache_t::postings by index id
+and word.
+@param[in]	p1	fts_postings_t*
+@param[in]	p2	fts_postings_t*
+@return < 0 if p1 < p2, 0 if p1 == p2, > 0 if p1 > p2 */
+static
+int
+fts_postings_cmp(
+	const void*	p1,
+	const void*	p2)
+{
+	const fts_postings_t*	postings1
+		= *static_cast<const fts_postings_t* const*>(p1);
+	const fts_postings_t*	postings2
+		= *static_cast<const fts_postings_t* const*>(p2);
+
+	if (postings1->index_id != postings2->index_id) {
+		return(postings1->index_id < postings2->index_id ? -1 : 1);
+	}
+
+	return(innobase_fts_text_cmp(
+		       postings1->charset, &postings1->word, &postings2->word));
+}
+
 /****************************************************************//**
 Create a FTS cache. */
 fts_cache_t*
@@ -637,6 +668,11 @@ fts_cache_create(
 
 	cache->stopword_info.status = STOPWORD_NOT_INIT;
 
+	cache->postings = rbt_create(
+		sizeof(fts_postings_t*), fts_postings_cmp);
+
+	UT_LIST_INIT(cache->postings_LRU, &fts_postings_t::LRU);
+
 	return(cache);
 }
 
@@ -1078,6 +1114,9 @@ fts_cache_clear(
 	mem_heap_free(static_cast<mem_heap_t*>(cache->sync_heap->arg));
 	cache->sync_heap->arg = NULL;
 
+	/* The SYNC that empties the cache modifies the FTS INDEX tables. */
+	fts_cache_postings_clear(cache);
+
 	fts_need_sync = false;
 
 	cache->total_size = 0;
@@ -1165,6 +1204,9 @@ fts_cache_destroy(
 		rbt_free(cache->stopword_info.cached_stopword);
 	}
 
+	fts_cache_postings_clear(cache);
+	rbt_free(cache->postings);
+
 	if (cache->sync_heap->arg) {
 		mem_heap_free(static_cast<mem_heap_t*>(cache->sync_heap->arg));
 	}
@@ -4465,6 +4507,8 @@ fts_sync_commit(
 	fts_cache_init(cache);
 	rw_lock_x_unlock(&cache->lock);
 
+	DEBUG_SYNC_C("fts_sync_before_commit");
+
 	if (error == DB_SUCCESS) {
 
 		fts_sql_commit(trx);
@@ -4476,6 +4520,13 @@ fts_sync_commit(
 		ib::error() << "(" << ut_strerr(error) << ") during SYNC.";
 	}
 
+	/* fts_cache_clear() emptied the cache of decoded posting lists,
+	but queries may have read the FTS INDEX tables again before the
+	SYNC was committed or rolled back. Discard what they read. */
+	rw_lock_x_lock(&cache->lock);
+	fts_cache_postings_clear(cache);
+	rw_lock_x_unlock(&cache->lock);
+
 	if (fts_enable_diag_print && elapsed_time) {
 		ib::info() << "SYNC for table " << sync->table->name
 			<< ": SYNC time: "
@@ -5481,6 +5532,205 @@ fts_cache_find_word(
 	return(nodes);
 }
 
+/** Remove a posting list from fts_cache_t::postings. It is freed when
+the last thread using it releases it.
+@param[in,out]	cache		FTS cache
+@param[in,out]	postings	cached posting list */
+static
+void
+fts_cache_postings_remove(
+	fts_cache_t*	cache,
+	fts_postings_t*	postings)
+{
+	ib_rbt_bound_t	parent;
+
+	ut_ad(postings->cached);
+
+	int	ret = rbt_search(cache->postings, &parent, &postings);
+	ut_a(ret == 0);
+
+	ut_free(rbt_remove_node(cache->postings, parent.last));
+
+	UT_LIST_REMOVE(cache->postings_LRU, postings);
+
+	ut_ad(cache->postings_size >= postings->size);
+	cache->postings_size -= postings->size;
+
+	postings->cached = false;
+
+	if (postings->n_ref == 0) {
+		ut_free(postings);
+	}
+}
+
+/** Empty fts_cache_t::postings, because the FTS INDEX tables were modified.
+@param[in,out]	cache		FTS cache */
+void
+fts_cache_postings_clear(
+	fts_cache_t*	cache)
+{
+	while (fts_postings_t* postings
+	       = UT_LIST_GET_LAST(cache->postings_LRU)) {
+
+		fts_cache_postings_remove(cache, postings);
+	}
+
+	ut_ad(cache->postings_size == 0);
+
+	++cache->postings_version;
+}
+
+/** Remove the decoded posting list of a word from fts_cache_t::postings,
+because the word's rows in the FTS INDEX table were modified. The caller
+must hold cache->lock in X mode.
+@param[in,out]	cache		FTS cache
+@param[in]	index		FTS index
+@param[in]	charset		charset of the FTS index
+@param[in]	word		modified word */
+void
+fts_cache_postings_invalidate(
+	fts_cache_t*		cache,
+	const dict_index_t*	index,
+	CHARSET_INFO*		charset,
+	const fts_string_t*	word)
+{
+	ib_rbt_bound_t	parent;
+	fts_postings_t	key;
+	fts_postings_t*	postings = &key;
+
+	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X));
+
+	key.index_id = index->id;
+	key.charset = charset;
+	key.word = *word;
+
+	if (rbt_search(cache->postings, &parent, &postings) == 0) {
+		fts_cache_postings_remove(
+			cache, *rbt_value(fts_postings_t*, parent.last));
+	}
+
+	/* Discard the posting lists that are being read. */
+	++cache->postings_version;
+}
+
+/** Look up the decoded posting list of a word in fts_cache_t::postings.
+The caller must hold cache->lock in S or X mode.
+@param[in,out]	cache		FTS cache
+@param[in]	index		FTS index
+@param[in]	charset		charset of the FTS index
+@param[in]	word		word to look up
+@return posting list, to be released with fts_cache_postings_release(),
+or NULL if it is not cached */
+fts_postings_t*
+fts_cache_postings_get(
+	fts_cache_t*		cache,
+	const dict_index_t*	index,
+	CHARSET_INFO*		charset,
+	const fts_string_t*	word)
+{
+	ib_rbt_bound_t	parent;
+	fts_postings_t	key;
+	fts_postings_t*	postings = &key;
+
+	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_S)
+	      || rw_lock_own(&cache->lock, RW_LOCK_X));
+
+	key.index_id = index->id;
+	key.charset = charset;
+	key.word = *word;
+
+	if (rbt_search(cache->postings, &parent, &postings) != 0) {
+		return(NULL);
+	}
+
+	postings = *rbt_value(fts_postings_t*, parent.last);
+
+	/* The LRU list can only be changed in X mode. Note the access
+	for fts_cache_postings_add() instead. */
+	postings->accessed = true;
+
+	os_atomic_increment_ulint(&postings->n_ref, 1);
+
+	return(postings);
+}
+
+/** Add a decoded posting list to fts_cache_t::postings, unless the
+FTS INDEX tables were modified since it was read, another thread
+added it first, or it is larger than fts_posting_cache_size. The oldest
+posting lists that were not accessed since the eviction last passed
+them are evicted to make room. The caller must hold cache->lock in
+X mode.
+@param[in,out]	cache		FTS cache
+@param[in,out]	postings	posting list, with n_ref == 1
+@param[in]	version		fts_cache_t::postings_version before
+				the posting list was read */
+void
+fts_cache_postings_add(
+	fts_cache_t*	cache,
+	fts_postings_t*	postings,
+	ib_uint64_t	version)
+{
+	ib_rbt_bound_t	parent;
+
+	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_X));
+	ut_ad(postings->n_ref == 1);
+	ut_ad(!postings->cached);
+
+	if (version != cache->postings_version
+	    || postings->size > fts_posting_cache_size
+	    || rbt_search(cache->postings, &parent, &postings) == 0) {
+
+		return;
+	}
+
+	while (cache->postings_size + postings->size
+	       > fts_posting_cache_size) {
+
+		fts_postings_t*	victim = UT_LIST_GET_LAST(cache->postings_LRU);
+
+		if (victim->accessed) {
+			victim->accessed = false;
+
+			UT_LIST_REMOVE(cache->postings_LRU, victim);
+			UT_LIST_ADD_FIRST(cache->postings_LRU, victim);
+		} else {
+			fts_cache_postings_remove(cache, victim);
+		}
+	}
+
+	/* The evictions may have changed the tree. */
+	rbt_search(cache->postings, &parent, &postings);
+	rbt_add_node(cache->postings, &parent, &postings);
+
+	UT_LIST_ADD_FIRST(cache->postings_LRU, postings);
+
+	cache->postings_size += postings->size;
+
+	postings->cached = true;
+	postings->accessed = false;
+}
+
+/** Release a posting list returned by fts_cache_postings_get() or
+added with fts_cache_postings_add(). The caller must hold cache->lock
+in S or X mode, so that postings->cached cannot change.
+@param[in]	cache		FTS cache
+@param[in,out]	postings	posting list */
+void
+fts_cache_postings_release(
+	const fts_cache_t*	cache,
+	fts_postings_t*		postings)
+{
+	ut_ad(rw_lock_own((rw_lock_t*) &cache->lock, RW_LOCK_S)
+	      || rw_lock_own((rw_lock_t*) &cache->lock, RW_LOCK_X));
+	ut_ad(postings->n_ref > 0);
+
+	if (os_atomic_decrement_ulint(&postings->n_ref, 1) == 0
+	    && !postings->cached) {
+
+		ut_free(postings);
+	}
+}
+
 /*********************************************************************//**
 Check cache for deleted doc id.
 @return TRUE if deleted */
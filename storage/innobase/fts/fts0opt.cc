@@ -1772,6 +1772,32 @@ fts_optimize_get_time_limit(
 }
 
 
+/** Remove the words that were just optimized from the cache of decoded
+posting lists, because their nodes were rewritten.
+@param[in]	optim	optimize instance
+@param[in]	index	FTS index being optimized */
+static
+void
+fts_optimize_invalidate_postings(
+	const fts_optimize_t*	optim,
+	const dict_index_t*	index)
+{
+	fts_cache_t*	cache = optim->table->fts->cache;
+
+	rw_lock_x_lock(&cache->lock);
+
+	for (ulint i = 0; i < ib_vector_size(optim->words); ++i) {
+		const fts_word_t*	word = static_cast<const fts_word_t*>(
+			ib_vector_get_const(optim->words, i));
+
+		fts_cache_postings_invalidate(
+			cache, index, optim->fts_index_table.charset,
+			&word->text);
+	}
+
+	rw_lock_x_unlock(&cache->lock);
+}
+
 /**********************************************************************//**
 Run OPTIMIZE on the given table. Note: this can take a very long time
 (hours). */
@@ -1828,6 +1854,9 @@ fts_optimize_words(
 
 			if (error == DB_SUCCESS) {
 				fts_sql_commit(optim->trx);
+
+				fts_optimize_invalidate_postings(
+					optim, index);
 			} else {
 				fts_sql_rollback(optim->trx);
 			}
@@ -42,6 +42,7 @@ Completed 2011/7/10 Sunny and Jimmy Yang
 #include "fts0vlc.ic"
 #endif
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
@@ -284,6 +285,18 @@ fts_query_index_fetch_nodes(
 	void*		row,		/*!< in: sel_node_t* */
 	void*		user_arg);	/*!< in: pointer to ib_vector_t */
 
+/** Read the documents of a word from the FTS INDEX table, or from the
+cache of decoded posting lists if the word is there.
+@param[in,out]	query	query instance
+@param[in]	token	word to read
+@return DB_SUCCESS or error code; DB_FTS_EXCEED_RESULT_CACHE_LIMIT is
+passed in query->error */
+static
+dberr_t
+fts_query_fetch_nodes(
+	fts_query_t*		query,
+	const fts_string_t*	token);
+
 /********************************************************************
 Read and filter nodes.
 @return fts_node_t instance */
@@ -1107,7 +1120,6 @@ fts_query_difference(
 	const fts_string_t*	token)	/*!< in: token to search */
 {
 	ulint			n_doc_ids= 0;
-	trx_t*			trx = query->trx;
 	dict_table_t*		table = query->index->table;
 
 	ut_a(query->oper == FTS_IGNORE);
@@ -1128,10 +1140,8 @@ fts_query_difference(
 	/* There is nothing we can substract from an empty set. */
 	if (query->doc_ids && !rbt_empty(query->doc_ids)) {
 		ulint			i;
-		fts_fetch_t		fetch;
 		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
-		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
 		dberr_t			error;
 
@@ -1169,21 +1179,13 @@ fts_query_difference(
 			return(query->error);
 		}
 
-		/* Setup the callback args for filtering and
-		consolidating the ilist. */
-		fetch.read_arg = query;
-		fetch.read_record = fts_query_index_fetch_nodes;
-
-		error = fts_index_fetch_nodes(
-			trx, &graph, &query->fts_index_table, token, &fetch);
+		error = fts_query_fetch_nodes(query, token);
 
 		/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 		ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
 		if (error != DB_SUCCESS) {
 			query->error = error;
 		}
-
-		fts_que_graph_free(graph);
 	}
 
 	/* The size can't increase. */
@@ -1202,7 +1204,6 @@ fts_query_intersect(
 	fts_query_t*		query,	/*!< in: query instance */
 	const fts_string_t*	token)	/*!< in: the token to search */
 {
-	trx_t*			trx = query->trx;
 	dict_table_t*		table = query->index->table;
 
 	ut_a(query->oper == FTS_EXIST);
@@ -1221,10 +1222,8 @@ fts_query_intersect(
 	if (!(rbt_empty(query->doc_ids) && query->multi_exist)) {
 		ulint                   n_doc_ids = 0;
 		ulint			i;
-		fts_fetch_t		fetch;
 		const ib_vector_t*	nodes;
 		const fts_index_cache_t*index_cache;
-		que_t*			graph = NULL;
 		fts_cache_t*		cache = table->fts->cache;
 		dberr_t			error;
 
@@ -1293,13 +1292,7 @@ fts_query_intersect(
 			return(query->error);
 		}
 
-		/* Setup the callback args for filtering and
-		consolidating the ilist. */
-		fetch.read_arg = query;
-		fetch.read_record = fts_query_index_fetch_nodes;
-
-		error = fts_index_fetch_nodes(
-			trx, &graph, &query->fts_index_table, token, &fetch);
+		error = fts_query_fetch_nodes(query, token);
 
 		/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 		ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -1307,8 +1300,6 @@ fts_query_intersect(
 			query->error = error;
 		}
 
-		fts_que_graph_free(graph);
-
 		if (query->error == DB_SUCCESS) {
 			/* Make the intesection (rb tree) the current doc id
 			set and free the old set. */
@@ -1384,10 +1375,7 @@ fts_query_union(
 	fts_query_t*		query,	/*!< in: query instance */
 	fts_string_t*		token)	/*!< in: token to search */
 {
-	fts_fetch_t		fetch;
 	ulint			n_doc_ids = 0;
-	trx_t*			trx = query->trx;
-	que_t*			graph = NULL;
 	dberr_t			error;
 
 	ut_a(query->oper == FTS_NONE || query->oper == FTS_DECR_RATING ||
@@ -1412,14 +1400,8 @@ fts_query_union(
 
 	fts_query_cache(query, token);
 
-	/* Setup the callback args for filtering and
-	consolidating the ilist. */
-	fetch.read_arg = query;
-	fetch.read_record = fts_query_index_fetch_nodes;
-
 	/* Read the nodes from disk. */
-	error = fts_index_fetch_nodes(
-		trx, &graph, &query->fts_index_table, token, &fetch);
+	error = fts_query_fetch_nodes(query, token);
 
 	/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 	ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -1427,8 +1409,6 @@ fts_query_union(
 		query->error = error;
 	}
 
-	fts_que_graph_free(graph);
-
 	if (query->error == DB_SUCCESS) {
 
 		/* The size can't decrease. */
@@ -2737,10 +2717,7 @@ fts_query_phrase_search(
 	/* Ignore empty strings. */
 	if (num_token > 0) {
 		fts_string_t*	token;
-		fts_fetch_t	fetch;
-		trx_t*		trx = query->trx;
 		fts_ast_oper_t	oper = query->oper;
-		que_t*		graph = NULL;
 		ulint		i;
 		dberr_t		error;
 
@@ -2775,11 +2752,6 @@ fts_query_phrase_search(
 			}
 		}
 
-		/* Setup the callback args for filtering and consolidating
-		the ilist. */
-		fetch.read_arg = query;
-		fetch.read_record = fts_query_index_fetch_nodes;
-
 		for (i = 0; i < num_token; i++) {
 			/* Search for the first word from the phrase. */
 			token = static_cast<fts_string_t*>(
@@ -2790,9 +2762,7 @@ fts_query_phrase_search(
 				query->matched = query->match_array[i];
 			}
 
-			error = fts_index_fetch_nodes(
-				trx, &graph, &query->fts_index_table,
-				token, &fetch);
+			error = fts_query_fetch_nodes(query, token);
 
 			/* DB_FTS_EXCEED_RESULT_CACHE_LIMIT passed by 'query->error' */
 			ut_ad(!(query->error != DB_SUCCESS && error != DB_SUCCESS));
@@ -2800,9 +2770,6 @@ fts_query_phrase_search(
 				query->error = error;
 			}
 
-			fts_que_graph_free(graph);
-			graph = NULL;
-
 			fts_query_cache(query, token);
 
 			if (!(query->flags & FTS_PHRASE)
@@ -3457,6 +3424,707 @@ fts_query_index_fetch_nodes(
 	}
 }
 
+/** Add a document of a decoded posting list to the query, like
+fts_query_filter_doc_ids() does for a document of an ilist.
+@param[in,out]	query		query instance
+@param[in]	word		the word
+@param[in,out]	word_freq	word frequency
+@param[in]	postings	posting list of the word
+@param[in]	doc		document in postings */
+static
+void
+fts_query_add_posting(
+	fts_query_t*		query,
+	const fts_string_t*	word,
+	fts_word_freq_t*	word_freq,
+	const fts_postings_t*	postings,
+	const fts_posting_t*	doc)
+{
+	fts_doc_freq_t*	doc_freq;
+
+	/* We simply collect the matching instances here. */
+	if (query->collect_positions) {
+		ib_alloc_t*	heap_alloc;
+		fts_match_t*	match;
+		ulint		last_pos;
+
+		/* Create a new fts_match_t instance. */
+		match = static_cast<fts_match_t*>(
+			ib_vector_push(query->matched, NULL));
+
+		match->start = 0;
+		match->doc_id = doc->doc_id;
+		heap_alloc = ib_vector_allocator(query->matched);
+
+		/* Allocate from the same heap as the
+		parent container. */
+		match->positions = ib_vector_create(
+			heap_alloc, sizeof(ulint), 64);
+
+		query->total_size += sizeof(fts_match_t)
+			+ sizeof(ib_vector_t)
+			+ sizeof(ulint) * 64;
+
+		for (ulint i = 0; i < doc->n_pos; i++) {
+			ib_vector_push(match->positions,
+				       &postings->positions[doc->pos + i]);
+		}
+
+		/* End of list marker. */
+		last_pos = (ulint) -1;
+
+		ib_vector_push(match->positions, &last_pos);
+	}
+
+	/* Add the doc id to the doc freq rb tree, if the doc id
+	doesn't exist it will be created. */
+	doc_freq = fts_query_add_doc_freq(
+		query, word_freq->doc_freqs, doc->doc_id);
+
+	/* Avoid duplicating frequency tally. */
+	if (doc_freq->freq == 0) {
+		doc_freq->freq = doc->n_pos;
+	}
+
+	/* We simply collect the matching documents and the
+	positions here and match later. */
+	if (!query->collect_positions) {
+		/* We ignore error here and will check it later */
+		fts_query_process_doc_id(query, doc->doc_id, 0);
+
+		/* Add the word to the document's matched RB tree. */
+		fts_query_add_word_to_document(query, doc->doc_id, word);
+	}
+}
+
+/** Compare the doc id of a document in a decoded posting list.
+@param[in]	doc	document
+@param[in]	doc_id	doc id
+@return whether doc is before doc_id */
+static
+bool
+fts_posting_doc_id_less(
+	const fts_posting_t&	doc,
+	doc_id_t		doc_id)
+{
+	return(doc.doc_id < doc_id);
+}
+
+/** Add the documents of a decoded posting list that are also in
+query->doc_ids to the query. Both lists are sorted by doc id, so they
+are merged, skipping ahead in either list by binary search.
+@param[in,out]	query		query instance
+@param[in]	word		the word
+@param[in,out]	word_freq	word frequency
+@param[in]	postings	posting list of the word
+@param[in]	first		first document to consider
+@param[in]	last		end of the documents to consider */
+static
+void
+fts_query_intersect_postings(
+	fts_query_t*		query,
+	const fts_string_t*	word,
+	fts_word_freq_t*	word_freq,
+	const fts_postings_t*	postings,
+	const fts_posting_t*	first,
+	const fts_posting_t*	last)
+{
+	const ib_rbt_node_t*	node = NULL;
+
+	if (first != last) {
+		node = rbt_lower_bound(query->doc_ids, &first->doc_id);
+	}
+
+	while (first != last && node != NULL) {
+		doc_id_t	doc_id = rbt_value(fts_ranking_t, node)->doc_id;
+
+		if (first->doc_id < doc_id) {
+			first = std::lower_bound(
+				first, last, doc_id, fts_posting_doc_id_less);
+		} else if (first->doc_id > doc_id) {
+			node = rbt_lower_bound(query->doc_ids, &first->doc_id);
+		} else {
+			/* This does not modify the shape of doc_ids. */
+			fts_query_add_posting(
+				query, word, word_freq, postings, first);
+
+			++first;
+			node = rbt_next(query->doc_ids, node);
+		}
+	}
+}
+
+/** Add the documents of a decoded posting list to the query, like
+fts_query_read_node() does for the rows of the FTS INDEX table.
+@param[in,out]	query		query instance
+@param[in]	token		the word searched
+@param[in]	postings	posting list of the word
+@return DB_SUCCESS or DB_FTS_EXCEED_RESULT_CACHE_LIMIT */
+static
+dberr_t
+fts_query_filter_postings(
+	fts_query_t*		query,
+	const fts_string_t*	token,
+	const fts_postings_t*	postings)
+{
+	ib_rbt_bound_t		parent;
+	fts_word_freq_t*	word_freq;
+
+	/* Lookup the word in our rb tree, it must exist. */
+	int	ret = rbt_search(query->word_freqs, &parent, token);
+
+	ut_a(ret == 0);
+
+	word_freq = rbt_value(fts_word_freq_t, parent.last);
+
+	const fts_string_t*	word = &word_freq->word;
+
+	word_freq->doc_count += postings->doc_count;
+
+	/* For '+a +b', only the documents that are already in doc_ids
+	can end up in the intersection. */
+	const bool	merge = query->oper == FTS_EXIST
+		&& query->multi_exist
+		&& !query->collect_positions;
+
+	for (ulint i = 0; i < postings->n_nodes; i++) {
+		const fts_postings_node_t*	node = &postings->nodes[i];
+
+		/* Skip nodes whose doc ids are out range. */
+		if (query->oper == FTS_EXIST
+		    && ((query->upper_doc_id > 0
+			 && node->first_doc_id > query->upper_doc_id)
+			|| (query->lower_doc_id > 0
+			    && node->last_doc_id < query->lower_doc_id))) {
+
+			continue;
+		}
+
+		const fts_posting_t*	first = postings->docs + node->first;
+		const fts_posting_t*	last = first + node->n_docs;
+
+		if (merge) {
+			fts_query_intersect_postings(
+				query, word, word_freq, postings,
+				first, last);
+		} else {
+			for (const fts_posting_t* doc = first;
+			     doc != last;
+			     ++doc) {
+
+				fts_query_add_posting(
+					query, word, word_freq, postings,
+					doc);
+			}
+		}
+
+		if (query->total_size > fts_result_cache_limit) {
+			return(DB_FTS_EXCEED_RESULT_CACHE_LIMIT);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
+/** Read the documents of a word from the FTS INDEX table, or from the
+cache of decoded posting lists if the word is there.
+@param[in,out]	query	query instance
+@param[in]	token	word to read
+@return DB_SUCCESS or error code; DB_FTS_EXCEED_RESULT_CACHE_LIMIT is
+passed in query->error */
+static
+dberr_t
+fts_query_fetch_nodes(
+	fts_query_t*		query,
+	const fts_string_t*	token)
+{
+	fts_fetch_t	fetch;
+	que_t*		graph = NULL;
+	dberr_t		error;
+
+	/* Wildcard terms match many words, they are not cached. */
+	if (fts_posting_cache_size > 0
+	    && (query->cur_node->type != FTS_AST_TERM
+		|| !query->cur_node->term.wildcard)) {
+
+		fts_cache_t*	cache = query->index->table->fts->cache;
+		fts_postings_t*	postings;
+
+		rw_lock_s_lock(&cache->lock);
+
+		postings = fts_cache_postings_get(
+			cache, query->index, query->fts_index_table.charset,
+			token);
+
+		rw_lock_s_unlock(&cache->lock);
+
+		if (postings != NULL) {
+			query->error = fts_query_filter_postings(
+				query, token, postings);
+
+			rw_lock_s_lock(&cache->lock);
+			fts_cache_postings_release(cache, postings);
+			rw_lock_s_unlock(&cache->lock);
+
+			return(DB_SUCCESS);
+		}
+	}
+
+	/* Setup the callback args for filtering and
+	consolidating the ilist. */
+	fetch.read_arg = query;
+	fetch.read_record = fts_query_index_fetch_nodes;
+
+	error = fts_index_fetch_nodes(
+		query->trx, &graph, &query->fts_index_table, token, &fetch);
+
+	fts_que_graph_free(graph);
+
+	return(error);
+}
+
+/** Allocator type used for postings_node_vector_t. */
+typedef ut_allocator<fts_postings_node_t>	postings_node_vector_allocator;
+
+/** Rows of a posting list being read. */
+typedef std::vector<fts_postings_node_t, postings_node_vector_allocator>
+	postings_node_vector_t;
+
+/** Allocator type used for posting_vector_t. */
+typedef ut_allocator<fts_posting_t>	posting_vector_allocator;
+
+/** Documents of a posting list being read. */
+typedef std::vector<fts_posting_t, posting_vector_allocator>
+	posting_vector_t;
+
+/** A posting list being read by fts_query_fetch_postings(). */
+struct fts_postings_fetch_t {
+	ulint			doc_count;	/*!< Sum of DOC_COUNT */
+	postings_node_vector_t	nodes;		/*!< Rows read so far */
+	posting_vector_t	docs;		/*!< Documents of the rows */
+	pos_vector_t		positions;	/*!< Word positions of the
+						documents */
+	bool			too_big;	/*!< Set if the posting list
+						is larger than
+						fts_posting_cache_size */
+};
+
+/** Compute the size of an fts_postings_t instance.
+@param[in]	n_nodes		number of rows
+@param[in]	n_docs		number of documents
+@param[in]	n_positions	number of word positions
+@param[in]	word_len	length of the word in bytes
+@return size in bytes */
+static
+ulint
+fts_postings_size(
+	ulint	n_nodes,
+	ulint	n_docs,
+	ulint	n_positions,
+	ulint	word_len)
+{
+	return(ut_calc_align(sizeof(fts_postings_t), sizeof(doc_id_t))
+	       + n_nodes * sizeof(fts_postings_node_t)
+	       + n_docs * sizeof(fts_posting_t)
+	       + n_positions * sizeof(ulint)
+	       + word_len);
+}
+
+/** Callback function to decode the rows of a word read from the FTS
+INDEX table by fts_query_fetch_postings().
+@param[in]	row		sel_node_t*
+@param[in,out]	user_arg	fts_fetch_t*
+@return whether to continue reading */
+static
+ibool
+fts_query_fetch_postings_node(
+	void*	row,
+	void*	user_arg)
+{
+	sel_node_t*		sel_node = static_cast<sel_node_t*>(row);
+	fts_fetch_t*		fetch = static_cast<fts_fetch_t*>(user_arg);
+	fts_postings_fetch_t*	state = static_cast<fts_postings_fetch_t*>(
+		fetch->read_arg);
+	que_node_t*		exp = sel_node->select_list;
+	fts_postings_node_t	node;
+	byte*			ilist = NULL;
+	ulint			ilist_len = 0;
+	ulint			i;
+
+	memset(&node, 0, sizeof(node));
+
+	/* Skip the word, the columns are those of the SELECT in
+	fts_index_fetch_nodes(). */
+	for (i = 1, exp = que_node_get_next(exp);
+	     exp != NULL;
+	     exp = que_node_get_next(exp), ++i) {
+
+		dfield_t*	dfield = que_node_get_val(exp);
+		byte*		data = static_cast<byte*>(
+			dfield_get_data(dfield));
+		ulint		len = dfield_get_len(dfield);
+
+		ut_a(len != UNIV_SQL_NULL);
+
+		switch (i) {
+		case 1: /* DOC_COUNT */
+			state->doc_count += mach_read_from_4(data);
+			break;
+
+		case 2: /* FIRST_DOC_ID */
+			node.first_doc_id = fts_read_doc_id(data);
+			break;
+
+		case 3: /* LAST_DOC_ID */
+			node.last_doc_id = fts_read_doc_id(data);
+			break;
+
+		case 4: /* ILIST */
+			ilist = data;
+			ilist_len = len;
+			break;
+
+		default:
+			ut_error;
+		}
+	}
+
+	ut_a(i == 5);
+
+	node.first = state->docs.size();
+
+	byte*		ptr = ilist;
+	doc_id_t	doc_id = 0;
+
+	/* Decode the ilist, see fts_query_filter_doc_ids(). */
+	while (ptr < ilist + ilist_len) {
+		fts_posting_t	doc;
+		ulint		last_pos = 0;
+		ulint		pos = fts_decode_vlc(&ptr);
+
+		/* Some sanity checks. */
+		if (doc_id == 0) {
+			ut_a(pos == node.first_doc_id);
+		}
+
+		/* Add the delta. */
+		doc_id += pos;
+
+		doc.doc_id = doc_id;
+		doc.pos = state->positions.size();
+
+		/* Unpack the positions within the document. */
+		while (*ptr) {
+			last_pos += fts_decode_vlc(&ptr);
+			state->positions.push_back(last_pos);
+		}
+
+		/* Skip the end of word position marker. */
+		++ptr;
+
+		doc.n_pos = state->positions.size() - doc.pos;
+
+		state->docs.push_back(doc);
+	}
+
+	/* Some sanity checks. */
+	ut_a(doc_id == node.last_doc_id);
+
+	node.n_docs = state->docs.size() - node.first;
+
+	state->nodes.push_back(node);
+
+	if (fts_postings_size(state->nodes.size(), state->docs.size(),
+			      state->positions.size(), FTS_MAX_WORD_LEN)
+	    > fts_posting_cache_size) {
+
+		state->too_big = true;
+
+		return(FALSE);
+	}
+
+	return(TRUE);
+}
+
+/** Read the rows of a word from the FTS INDEX table and decode them.
+@param[in,out]	trx		transaction
+@param[in]	index		FTS index
+@param[in,out]	fts_table	FTS INDEX table of the index
+@param[in]	word		word without wildcard
+@return posting list with n_ref == 1, or NULL if the rows could not be
+read or would not fit in fts_posting_cache_size */
+static
+fts_postings_t*
+fts_query_fetch_postings(
+	trx_t*			trx,
+	const dict_index_t*	index,
+	fts_table_t*		fts_table,
+	const fts_string_t*	word)
+{
+	fts_postings_fetch_t	state;
+	fts_fetch_t		fetch;
+	que_t*			graph = NULL;
+	dberr_t			error;
+
+	state.doc_count = 0;
+	state.too_big = false;
+
+	fetch.read_arg = &state;
+	fetch.read_record = fts_query_fetch_postings_node;
+
+	error = fts_index_fetch_nodes(trx, &graph, fts_table, word, &fetch);
+
+	fts_que_graph_free(graph);
+
+	if (error != DB_SUCCESS || state.too_big) {
+		return(NULL);
+	}
+
+	ulint	n_nodes = state.nodes.size();
+	ulint	n_docs = state.docs.size();
+	ulint	n_positions = state.positions.size();
+	ulint	size = fts_postings_size(
+		n_nodes, n_docs, n_positions, word->f_len);
+	byte*	ptr = static_cast<byte*>(ut_malloc_nokey(size));
+
+	fts_postings_t*	postings = reinterpret_cast<fts_postings_t*>(ptr);
+
+	ptr += ut_calc_align(sizeof(fts_postings_t), sizeof(doc_id_t));
+
+	postings->nodes = reinterpret_cast<fts_postings_node_t*>(ptr);
+	ptr += n_nodes * sizeof(fts_postings_node_t);
+
+	postings->docs = reinterpret_cast<fts_posting_t*>(ptr);
+	ptr += n_docs * sizeof(fts_posting_t);
+
+	postings->positions = reinterpret_cast<ulint*>(ptr);
+	ptr += n_positions * sizeof(ulint);
+
+	if (n_nodes > 0) {
+		memcpy(postings->nodes, &state.nodes[0],
+		       n_nodes * sizeof(fts_postings_node_t));
+	}
+
+	if (n_docs > 0) {
+		memcpy(postings->docs, &state.docs[0],
+		       n_docs * sizeof(fts_posting_t));
+	}
+
+	if (n_positions > 0) {
+		memcpy(postings->positions, &state.positions[0],
+		       n_positions * sizeof(ulint));
+	}
+
+	memcpy(ptr, word->f_str, word->f_len);
+
+	postings->word.f_str = ptr;
+	postings->word.f_len = word->f_len;
+	postings->word.f_n_char = word->f_n_char;
+
+	postings->index_id = index->id;
+	postings->charset = fts_table->charset;
+	postings->doc_count = state.doc_count;
+	postings->n_nodes = n_nodes;
+	postings->size = size;
+	postings->n_ref = 1;
+	postings->cached = false;
+	postings->accessed = false;
+
+	return(postings);
+}
+
+/** Terms of a query whose posting lists are read into the cache in
+parallel by the thread executing fts_query_prefetch() and a number of
+fts_query_prefetch_thread(). */
+struct fts_query_prefetch_t {
+	const fts_query_t*	query;	/*!< query instance */
+	const fts_string_t*	words;	/*!< terms to read, which were
+					not in the cache */
+	ulint			n_words;/*!< size of words[] */
+	ib_uint64_t		version;/*!< fts_cache_t::postings_version
+					when the cache was looked up */
+	volatile ulint		next;	/*!< number of terms that have
+					been taken by the threads; may
+					exceed n_words */
+	OSThreadGroup		threads;/*!< the reading threads */
+};
+
+/** Read the posting lists of the terms of a query into the cache until
+there are none left.
+@param[in,out]	prefetch	terms being read */
+static
+void
+fts_query_prefetch_words(
+	fts_query_prefetch_t*	prefetch)
+{
+	const fts_query_t*	query = prefetch->query;
+	fts_cache_t*		cache = query->index->table->fts->cache;
+	fts_table_t		fts_table = query->fts_index_table;
+	trx_t*			trx = NULL;
+
+	for (;;) {
+		ulint	i = os_atomic_increment_ulint(&prefetch->next, 1) - 1;
+
+		if (i >= prefetch->n_words) {
+			break;
+		}
+
+		if (trx == NULL) {
+			trx = trx_allocate_for_background();
+			trx->op_info = "FTS query prefetch";
+		}
+
+		fts_postings_t*	postings = fts_query_fetch_postings(
+			trx, query->index, &fts_table, &prefetch->words[i]);
+
+		if (postings != NULL) {
+			rw_lock_x_lock(&cache->lock);
+			fts_cache_postings_add(
+				cache, postings, prefetch->version);
+			fts_cache_postings_release(cache, postings);
+			rw_lock_x_unlock(&cache->lock);
+		}
+	}
+
+	if (trx != NULL) {
+		trx_free_for_background(trx);
+	}
+}
+
+/** Thread that reads posting lists for fts_query_prefetch().
+@param[in,out]	arg	fts_query_prefetch_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(fts_query_prefetch_thread)(
+	void*	arg)
+{
+	fts_query_prefetch_t*	prefetch
+		= static_cast<fts_query_prefetch_t*>(arg);
+
+	fts_query_prefetch_words(prefetch);
+
+	prefetch->threads.exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Collect the distinct terms without wildcard of a query.
+@param[in]	node	first node of an expression list
+@param[in]	charset	charset of the FTS index
+@param[in,out]	words	terms */
+static
+void
+fts_query_collect_terms(
+	const fts_ast_node_t*	node,
+	CHARSET_INFO*		charset,
+	word_vector_t*		words)
+{
+	for (; node != NULL; node = node->next) {
+		switch (node->type) {
+		case FTS_AST_TERM:
+			if (!node->term.wildcard && node->term.ptr->len > 0) {
+				fts_string_t	word;
+
+				word.f_str = node->term.ptr->str;
+				word.f_len = node->term.ptr->len;
+				word.f_n_char = 0;
+
+				word_vector_t::const_iterator	it;
+
+				for (it = words->begin();
+				     it != words->end()
+				     && innobase_fts_text_cmp(
+					     charset, &*it, &word) != 0;
+				     ++it) {
+				}
+
+				if (it == words->end()) {
+					words->push_back(word);
+				}
+			}
+			break;
+
+		case FTS_AST_LIST:
+		case FTS_AST_SUBEXP_LIST:
+			fts_query_collect_terms(
+				node->list.head, charset, words);
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+/** Read the posting lists of the terms of a query that are not in the
+cache of decoded posting lists yet, using up to fts_query_pll_degree
+threads. The cache is looked up by the calling thread, so that threads
+are only started for the misses. The AST is then evaluated from the
+cache. Phrases and wildcard terms are read during the evaluation as
+before.
+@param[in]	query	query instance */
+static
+void
+fts_query_prefetch(
+	const fts_query_t*	query)
+{
+	fts_cache_t*		cache = query->index->table->fts->cache;
+	CHARSET_INFO*		charset = query->fts_index_table.charset;
+	word_vector_t		words;
+	word_vector_t		misses;
+	fts_query_prefetch_t	prefetch;
+
+	if (fts_posting_cache_size == 0) {
+		return;
+	}
+
+	fts_query_collect_terms(query->root, charset, &words);
+
+	rw_lock_s_lock(&cache->lock);
+
+	prefetch.version = cache->postings_version;
+
+	for (word_vector_t::const_iterator it = words.begin();
+	     it != words.end(); ++it) {
+
+		fts_postings_t*	postings = fts_cache_postings_get(
+			cache, query->index, charset, &*it);
+
+		if (postings != NULL) {
+			fts_cache_postings_release(cache, postings);
+		} else {
+			misses.push_back(*it);
+		}
+	}
+
+	rw_lock_s_unlock(&cache->lock);
+
+	if (misses.empty()) {
+		return;
+	}
+
+	prefetch.query = query;
+	prefetch.words = &misses[0];
+	prefetch.n_words = misses.size();
+	prefetch.next = 0;
+
+	ulint	n_threads = std::min(
+		prefetch.n_words, ulint(fts_query_pll_degree)) - 1;
+
+	for (ulint i = 0; i < n_threads; i++) {
+		if (!prefetch.threads.start(fts_query_prefetch_thread,
+					    &prefetch)) {
+			break;
+		}
+	}
+
+	/* This thread reads posting lists as well. */
+	fts_query_prefetch_words(&prefetch);
+
+	prefetch.threads.join();
+}
+
 /*****************************************************************//**
 Calculate the inverse document frequency (IDF) for all the terms. */
 static
@@ -4051,6 +4719,9 @@ fts_query(
 			        fts_result_cache_limit = 2048;
 		);
 
+		/* Read the posting lists of the terms in parallel. */
+		fts_query_prefetch(&query);
+
 		/* Traverse the Abstract Syntax Tree (AST) and execute
 		the query. */
 		query.error = fts_ast_visit(
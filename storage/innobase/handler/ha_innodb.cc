@@ -370,7 +370,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	PSI_KEY(trx_pool_mutex),
 	PSI_KEY(trx_pool_manager_mutex),
 	PSI_KEY(srv_sys_mutex),
-	PSI_KEY(lock_mutex),
+	PSI_KEY(lock_sys_shard_mutex),
 	PSI_KEY(lock_wait_mutex),
 	PSI_KEY(trx_mutex),
 	PSI_KEY(srv_threads_mutex),
@@ -409,6 +409,7 @@ static PSI_rwlock_info all_innodb_rwlocks[] = {
 	PSI_RWLOCK_KEY(index_online_log),
 	PSI_RWLOCK_KEY(dict_table_stats),
 	PSI_RWLOCK_KEY(hash_table_locks),
+	PSI_RWLOCK_KEY(lock_sys_latch),
 #  ifdef UNIV_DEBUG
 	PSI_RWLOCK_KEY(buf_chunk_map_latch)
 #  endif /* UNIV_DEBUG */
@@ -427,7 +428,9 @@ static PSI_thread_info	all_innodb_threads[] = {
 	PSI_KEY(io_log_thread),
 	PSI_KEY(io_read_thread),
 	PSI_KEY(io_write_thread),
+	PSI_KEY(log_flusher_thread),
 	PSI_KEY(page_cleaner_thread),
+	PSI_KEY(recv_apply_thread),
 	PSI_KEY(recv_writer_thread),
 	PSI_KEY(srv_error_monitor_thread),
 	PSI_KEY(srv_lock_timeout_thread),
@@ -2141,7 +2144,7 @@ Compression::is_none(const char* algorithm)
 	return(false);
 }
 
-/** Check for supported COMPRESS := (ZLIB | LZ4 | NONE) supported values
+/** Check for supported COMPRESS := (ZLIB | LZ4 | LZ4HC | NONE) values
 @param[in]	name		Name of the compression algorithm
 @param[out]	compression	The compression algorithm
 @return DB_SUCCESS or DB_UNSUPPORTED */
@@ -2162,6 +2165,10 @@ Compression::check(
 
 		compression->m_type = LZ4;
 
+	} else if (innobase_strcasecmp(algorithm, "lz4hc") == 0) {
+
+		compression->m_type = LZ4HC;
+
 	} else {
 		return(DB_UNSUPPORTED);
 	}
@@ -2169,7 +2176,7 @@ Compression::check(
 	return(DB_SUCCESS);
 }
 
-/** Check for supported COMPRESS := (ZLIB | LZ4 | NONE) supported values
+/** Check for supported COMPRESS := (ZLIB | LZ4 | LZ4HC | NONE) values
 @param[in]	name		Name of the compression algorithm
 @param[out]	compression	The compression algorithm
 @return DB_SUCCESS or DB_UNSUPPORTED */
@@ -18593,6 +18600,13 @@ static MYSQL_SYSVAR_ULONGLONG(stats_persistent_sample_pages,
   " statistics (by ANALYZE, default 20)",
   NULL, NULL, 20, 1, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(stats_pll_degree, srv_stats_pll_degree,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that analyze the indexes of a table in parallel"
+  " when calculating persistent statistics (by ANALYZE or automatic"
+  " recalculation); 1 analyzes them one by one",
+  NULL, NULL, 4, 1, 16, 0);
+
 static MYSQL_SYSVAR_BOOL(adaptive_hash_index, btr_search_enabled,
   PLUGIN_VAR_OPCMDARG,
   "Enable InnoDB adaptive hash index (enabled by default). "
@@ -18774,6 +18788,18 @@ static MYSQL_SYSVAR_ULONG(ft_result_cache_limit, fts_result_cache_limit,
   "InnoDB Fulltext search query result cache limit in bytes",
   NULL, NULL, 2000000000L, 1000000L, 4294967295UL, 0);
 
+static MYSQL_SYSVAR_ULONG(ft_posting_cache_size, fts_posting_cache_size,
+  PLUGIN_VAR_RQCMDARG,
+  "InnoDB Fulltext search cache size in bytes for the decoded posting"
+  " lists of the words searched in each table; 0 disables the cache",
+  NULL, NULL, 8000000, 0, 80000000, 0);
+
+static MYSQL_SYSVAR_ULONG(ft_query_pll_degree, fts_query_pll_degree,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads used to read the posting lists of the words of"
+  " an InnoDB Fulltext search query into the posting list cache",
+  NULL, NULL, 2, 1, 16, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_min_token_size, fts_min_token_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search minimum token size in characters",
@@ -18799,6 +18825,18 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(sort_pll_degree, srv_sort_pll_degree,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads used to merge sort the secondary index entries"
+  " in index creation; 1 sorts all indexes in the ALTER TABLE thread",
+  NULL, NULL, 4, 1, 16, 0);
+
+static MYSQL_SYSVAR_ULONG(sort_merge_ways, srv_sort_merge_ways,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of sorted runs merged in one pass over the index"
+  " creation sort files; each run needs innodb_sort_buffer_size bytes",
+  NULL, NULL, 8, 2, ROW_MERGE_MAX_WAYS, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -18819,6 +18857,11 @@ static MYSQL_SYSVAR_ULONG(write_io_threads, innobase_write_io_threads,
   "Number of background write I/O threads in InnoDB.",
   NULL, NULL, 4, 1, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_n_recv_apply_threads,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Number of threads applying redo log records during crash recovery.",
+  NULL, NULL, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(force_recovery, srv_force_recovery,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Helps to save your data in case the disk image of the database becomes corrupt.",
@@ -19110,6 +19153,13 @@ static MYSQL_SYSVAR_BOOL(print_all_deadlocks, srv_print_all_deadlocks,
   "Print all deadlocks to MySQL error log (off by default)",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(deadlock_detect_async, srv_deadlock_detect_async,
+  PLUGIN_VAR_OPCMDARG,
+  "Do not search for deadlocks when a lock wait is enqueued; let the"
+  " lock wait timeout thread detect and resolve them in the background"
+  " (off by default)",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(compression_failure_threshold_pct,
   zip_failure_threshold_pct, PLUGIN_VAR_OPCMDARG,
   "If the compression failure rate of a table is greater than this number"
@@ -19208,6 +19258,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(fast_shutdown),
   MYSQL_SYSVAR(read_io_threads),
   MYSQL_SYSVAR(write_io_threads),
+  MYSQL_SYSVAR(recovery_apply_threads),
   MYSQL_SYSVAR(file_per_table),
   MYSQL_SYSVAR(file_format),
   MYSQL_SYSVAR(file_format_check),
@@ -19227,6 +19278,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(ft_max_token_size),
   MYSQL_SYSVAR(ft_min_token_size),
   MYSQL_SYSVAR(ft_num_word_optimize),
+  MYSQL_SYSVAR(ft_posting_cache_size),
+  MYSQL_SYSVAR(ft_query_pll_degree),
   MYSQL_SYSVAR(ft_sort_pll_degree),
   MYSQL_SYSVAR(large_prefix),
   MYSQL_SYSVAR(force_load_corrupted),
@@ -19263,6 +19316,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
   MYSQL_SYSVAR(stats_auto_recalc),
+  MYSQL_SYSVAR(stats_pll_degree),
   MYSQL_SYSVAR(adaptive_hash_index),
   MYSQL_SYSVAR(adaptive_hash_index_parts),
   MYSQL_SYSVAR(stats_method),
@@ -19271,6 +19325,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(support_xa),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(sort_pll_degree),
+  MYSQL_SYSVAR(sort_merge_ways),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -19313,6 +19369,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_output),
   MYSQL_SYSVAR(status_output_locks),
   MYSQL_SYSVAR(print_all_deadlocks),
+  MYSQL_SYSVAR(deadlock_detect_async),
   MYSQL_SYSVAR(cmp_per_index_enabled),
   MYSQL_SYSVAR(undo_logs),
   MYSQL_SYSVAR(max_undo_log_size),
@@ -300,6 +300,10 @@ const ulint		IBUF_MERGE_THRESHOLD = 4;
 batch, in order to merge the entries for them in the insert buffer */
 const ulint		IBUF_MAX_N_PAGES_MERGED = IBUF_MERGE_AREA;
 
+/** In ibuf_merge_in_background() at most this number of pages is read to
+memory in one batch, in the (space, page) order of the ibuf tree */
+const ulint		IBUF_MAX_N_PAGES_MERGED_BG = 64;
+
 /** If the combined size of the ibuf trees exceeds ibuf->max_size by this
 many pages, we start to contract it in connection to inserts there, using
 non-synchronous contract */
@@ -2632,10 +2636,137 @@ ibuf_merge_space(
 	return(sum_sizes);
 }
 
+/** Contract the change buffer by reading pages to the buffer pool in the
+(space, page) order of the ibuf tree, continuing from where the previous
+call stopped, so that the reads are mostly sequential and every page
+gets merged in turn.
+@param[out]	n_pages	number of pages to which merged
+@param[in]	limit	maximum number of pages to read
+@return a lower limit for the combined size in bytes of entries which
+will be merged from ibuf trees to the pages read, 0 if ibuf is
+empty */
+static
+ulint
+ibuf_merge_pages_in_order(
+	ulint*	n_pages,
+	ulint	limit)
+{
+	mtr_t		mtr;
+	btr_pcur_t	pcur;
+	mem_heap_t*	heap = mem_heap_create(512);
+	dtuple_t*	tuple = ibuf_search_tuple_build(
+		ibuf->merge_space, ibuf->merge_page_no, heap);
+	ulint		sum_sizes = 0;
+	ulint		pages[IBUF_MAX_N_PAGES_MERGED_BG];
+	ulint		spaces[IBUF_MAX_N_PAGES_MERGED_BG];
+
+	limit = ut_min(limit, UT_ARR_SIZE(pages));
+
+	*n_pages = 0;
+
+	ibuf_mtr_start(&mtr);
+
+	btr_pcur_open(
+		ibuf->index, tuple, PAGE_CUR_GE, BTR_SEARCH_LEAF, &pcur,
+		&mtr);
+
+	mem_heap_free(heap);
+
+	ut_ad(page_validate(btr_pcur_get_page(&pcur), ibuf->index));
+
+	if (page_is_empty(btr_pcur_get_page(&pcur))) {
+		/* If a B-tree page is empty, it must be the root page
+		and the whole B-tree must be empty. InnoDB does not
+		allow empty B-tree pages other than the root. */
+		ut_ad(ibuf->empty);
+		ut_ad(page_get_space_id(btr_pcur_get_page(&pcur))
+		      == IBUF_SPACE_ID);
+		ut_ad(page_get_page_no(btr_pcur_get_page(&pcur))
+		      == FSP_IBUF_TREE_ROOT_PAGE_NO);
+
+	} else {
+		const rec_t*	rec;
+
+		while (*n_pages < limit
+		       && (rec = ibuf_get_user_rec(&pcur, &mtr)) != 0) {
+
+			ulint	space = ibuf_rec_get_space(&mtr, rec);
+			ulint	page_no = ibuf_rec_get_page_no(&mtr, rec);
+
+			if (*n_pages == 0
+			    || pages[*n_pages - 1] != page_no
+			    || spaces[*n_pages - 1] != space) {
+				spaces[*n_pages] = space;
+				pages[*n_pages] = page_no;
+				++*n_pages;
+			}
+
+			sum_sizes += ibuf_rec_get_volume(&mtr, rec);
+
+			btr_pcur_move_to_next(&pcur, &mtr);
+		}
+
+		++sum_sizes;
+	}
+
+	ibuf_mtr_commit(&mtr);
+
+	btr_pcur_close(&pcur);
+
+	if (*n_pages == limit) {
+		/* The entries of the last page are merged as a whole
+		when the page is read. */
+		ibuf->merge_space = spaces[*n_pages - 1];
+		ibuf->merge_page_no = pages[*n_pages - 1] + 1;
+	} else {
+		/* We reached the end of the tree. Start from the
+		beginning next time. */
+		if (*n_pages == 0 && sum_sizes > 0
+		    && ibuf->merge_space == 0 && ibuf->merge_page_no == 0) {
+			sum_sizes = 0;
+		}
+
+		ibuf->merge_space = 0;
+		ibuf->merge_page_no = 0;
+	}
+
+	if (*n_pages > 0) {
+		buf_read_ibuf_merge_pages(false, spaces, pages, *n_pages);
+	}
+
+	return(sum_sizes);
+}
+
+/** Estimate the I/O capacity that is left unused.
+@return the number of page I/O per second that innodb_io_capacity allows
+beyond the buffer pool page reads and writes since the previous call */
+static
+ulint
+ibuf_get_spare_io_capacity()
+{
+	buf_pool_stat_t	stat;
+
+	buf_get_total_stat(&stat);
+
+	ulint		n_io = stat.n_pages_read + stat.n_pages_written;
+	uintmax_t	now = ut_time_us(NULL);
+	ulint		io_per_sec = 0;
+
+	if (ibuf->merge_io_time != 0 && now > ibuf->merge_io_time) {
+		io_per_sec = ulint((n_io - ibuf->merge_n_io) * 1000000
+				   / (now - ibuf->merge_io_time));
+	}
+
+	ibuf->merge_n_io = n_io;
+	ibuf->merge_io_time = now;
+
+	return(srv_io_capacity > io_per_sec
+	       ? srv_io_capacity - io_per_sec : 0);
+}
+
 /** Contract the change buffer by reading pages to the buffer pool.
 @param[out]	n_pages		number of pages merged
-@param[in]	sync		whether the caller waits for
-the issued reads to complete
+@param[in]	limit		maximum number of pages to merge
 @param[in]	space_id	tablespace for which to merge, or
 ULINT_UNDEFINED for all tablespaces
 @return a lower limit for the combined size in bytes of entries which
@@ -2645,7 +2776,7 @@ static __attribute__((warn_unused_result))
 ulint
 ibuf_merge(
 	ulint*		n_pages,
-	bool		sync,
+	ulint		limit,
 	ulint		space_id)
 {
 	*n_pages = 0;
@@ -2662,7 +2793,7 @@ ibuf_merge(
 		return(0);
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
 	} else if (space_id == ULINT_UNDEFINED) {
-		return(ibuf_merge_pages(n_pages, sync));
+		return(ibuf_merge_pages_in_order(n_pages, limit));
 	} else {
 		return(ibuf_merge_space(space_id, n_pages));
 	}
@@ -2712,9 +2843,18 @@ ibuf_merge_in_background(
 		/* Caller has requested a full batch */
 		n_pages = PCT_IO(100);
 	} else {
-		/* By default we do a batch of 5% of the io_capacity */
+		/* By default we do a batch of 5% of the io_capacity,
+		and use half of the capacity that the other page reads
+		and writes left unused, so that pages get merged before
+		a user thread reads them. */
 		n_pages = PCT_IO(5);
 
+		if (space_id == ULINT_UNDEFINED) {
+			n_pages = ut_min(
+				n_pages + ibuf_get_spare_io_capacity() / 2,
+				ulint(PCT_IO(100)));
+		}
+
 		mutex_enter(&ibuf_mutex);
 
 		/* If the ibuf->size is more than half the max_size
@@ -2732,7 +2872,7 @@ ibuf_merge_in_background(
 	while (sum_pages < n_pages) {
 		ulint	n_bytes;
 
-		n_bytes = ibuf_merge(&n_pag2, false, space_id);
+		n_bytes = ibuf_merge(&n_pag2, n_pages - sum_pages, space_id);
 
 		if (n_bytes == 0) {
 			return(sum_bytes);
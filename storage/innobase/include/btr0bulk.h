@@ -53,13 +53,16 @@ public:
 	@param[in]	page_no		page number
 	@param[in]	level		page level
 	@param[in]	trx_id		transaction id
-	@param[in]	observer	flush observer */
+	@param[in]	observer	flush observer
+	@param[in]	hint_page_no	page number to allocate the page
+	near when page_no is FIL_NULL, or 0 */
 	PageBulk(
 		dict_index_t*	index,
 		trx_id_t	trx_id,
 		ulint		page_no,
 		ulint		level,
-		FlushObserver*	observer)
+		FlushObserver*	observer,
+		ulint		hint_page_no = 0)
 		:
 		m_heap(NULL),
 		m_index(index),
@@ -80,7 +83,8 @@ public:
 		m_total_data(0),
 #endif /* UNIV_DEBUG */
 		m_modify_clock(0),
-		m_flush_observer(observer)
+		m_flush_observer(observer),
+		m_hint_page_no(hint_page_no)
 	{
 		ut_ad(!dict_index_is_spatial(m_index));
 	}
@@ -252,6 +256,9 @@ private:
 
 	/** Flush observer */
 	FlushObserver*	m_flush_observer;
+
+	/** Page number to allocate a new page near */
+	ulint		m_hint_page_no;
 };
 
 typedef std::vector<PageBulk*, ut_allocator<PageBulk*> >
@@ -263,16 +270,21 @@ public:
 	/** Constructor
 	@param[in]	index		B-tree index
 	@param[in]	trx_id		transaction id
-	@param[in]	observer	flush observer */
+	@param[in]	observer	flush observer
+	@param[in]	aborted		flag that the ALTER TABLE thread sets to
+	stop a bulk load in a merge sort thread, or NULL to check the
+	interruption of the transaction of the flush observer */
 	BtrBulk(
-		dict_index_t*	index,
-		trx_id_t	trx_id,
-		FlushObserver*	observer)
+		dict_index_t*		index,
+		trx_id_t		trx_id,
+		FlushObserver*		observer,
+		const volatile bool*	aborted = NULL)
 		:
 		m_heap(NULL),
 		m_index(index),
 		m_trx_id(trx_id),
-		m_flush_observer(observer)
+		m_flush_observer(observer),
+		m_aborted(aborted)
 	{
 		ut_ad(m_flush_observer != NULL);
 #ifdef UNIV_DEBUG
@@ -375,6 +387,9 @@ private:
 	/** Flush observer */
 	FlushObserver*		m_flush_observer;
 
+	/** Abort flag of a merge sort thread, or NULL */
+	const volatile bool*	m_aborted;
+
 	/** Page cursor vector for all level */
 	page_bulk_vector*	m_page_bulks;
 };
@@ -33,6 +33,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "btr0types.h"
 #include "mtr0mtr.h"
 #include "ha0ha.h"
+#include "ut0counter.h"
 
 /** Creates and initializes the adaptive search system at a database start.
 @param[in]	hash_size	hash table size. */
@@ -218,6 +219,8 @@ UNIV_INLINE
 void
 btr_search_s_unlock_all();
 
+struct btr_search_part_stats_t;
+
 /** Get the latch based on index attributes.
 A latch is selected from an array of latches using pair of index-id, space-id.
 @param[in]	index	index handler
@@ -234,6 +237,43 @@ UNIV_INLINE
 hash_table_t*
 btr_get_search_table(const dict_index_t* index);
 
+/** Get the adaptive hash index partition statistics for a b-tree.
+@param[in]	index	b-tree index
+@return statistics of the partition the index belongs to */
+UNIV_INLINE
+btr_search_part_stats_t*
+btr_get_search_stats(const dict_index_t* index);
+
+/** Acquire the adaptive hash index latch of a b-tree in shared mode.
+A latch wait is counted if the latch is not immediately available.
+@param[in]	index	b-tree index
+@param[in]	file	file name where the latch is requested
+@param[in]	line	line where requested */
+UNIV_INLINE
+void
+btr_search_s_lock_func(
+	const dict_index_t*	index,
+	const char*		file,
+	ulint			line);
+
+/** Acquire the adaptive hash index latch of a b-tree in exclusive mode.
+A latch wait is counted if the latch is not immediately available.
+@param[in]	index	b-tree index
+@param[in]	file	file name where the latch is requested
+@param[in]	line	line where requested */
+UNIV_INLINE
+void
+btr_search_x_lock_func(
+	const dict_index_t*	index,
+	const char*		file,
+	ulint			line);
+
+#define btr_search_s_lock(index)				\
+	btr_search_s_lock_func((index), __FILE__, __LINE__)
+
+#define btr_search_x_lock(index)				\
+	btr_search_x_lock_func((index), __FILE__, __LINE__)
+
 /** The search info struct in an index */
 struct btr_search_t{
 	ulint	ref_count;	/*!< Number of blocks in this index tree
@@ -291,11 +331,32 @@ struct btr_search_t{
 #endif /* UNIV_DEBUG */
 };
 
+/** Statistics of one adaptive hash index partition. The counters are
+updated without any latch protection and are therefore approximate.
+Each entry is padded to the size of a cache line, and the array is
+aligned to CACHE_LINE_SIZE, so that the counters of different
+partitions never share a cache line. */
+struct btr_search_part_stats_t{
+	ulint	n_hits;		/*!< number of successful hash searches */
+	ulint	n_misses;	/*!< number of failed hash searches */
+	ulint	n_latch_waits;	/*!< number of times the partition latch
+				was not immediately available */
+	byte	pad[CACHE_LINE_SIZE - 3 * sizeof(ulint)];
+				/*!< padding to the size of a cache
+				line */
+};
+
 /** The hash index system */
 struct btr_search_sys_t{
 	hash_table_t**	hash_tables;	/*!< the adaptive hash tables,
 					mapping dtuple_fold values
 					to rec_t pointers on index pages */
+	btr_search_part_stats_t*
+			part_stats;	/*!< statistics, one entry per
+					partition (btr_ahi_parts), aligned
+					to CACHE_LINE_SIZE */
+	void*		part_stats_unaligned;
+					/*!< the allocation of part_stats */
 };
 
 /** Latches protecting access to adaptive hash index. */
@@ -1573,6 +1573,11 @@ public:
 					@see buf_flush_t */
 	unsigned	buf_pool_index:6;/*!< index number of the buffer pool
 					that this block belongs to */
+	unsigned	load_read:1;	/*!< TRUE if the pending read of
+					this block was requested by
+					buf_load(); protected by the
+					block mutex
+					@see buf_load_n_pending_reads */
 # if MAX_BUFFER_POOLS > 64
 #  error "MAX_BUFFER_POOLS > 64; redefine buf_pool_index:6"
 # endif
@@ -2167,6 +2172,17 @@ struct buf_pool_t{
 					we flush a batch from the
 					buffer pool. Protected by the
 					buf_pool->mutex */
+	ulint		LRU_free_target;/*!< number of free blocks that
+					the LRU flush tries to keep on
+					the free list, derived from the
+					recent block consumption rate;
+					protected by buf_pool->mutex */
+	ulint		LRU_free_last_used;/*!< stat.n_pages_read plus
+					stat.n_pages_created when
+					LRU_free_target was computed */
+	ulint		LRU_free_last_time;/*!< ut_time_ms() when
+					LRU_free_target was computed,
+					or 0 if never */
 	/* @} */
 
 	/** @name LRU replacement algorithm fields */
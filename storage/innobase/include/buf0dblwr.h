@@ -99,15 +99,15 @@ written to the dblwr buffer on disk. */
 void
 buf_dblwr_sync_datafiles();
 
-/********************************************************************//**
-Flushes possible buffered writes from the doublewrite memory buffer to disk,
-and also wakes up the aio thread if simulated aio is used. It is very
-important to call this function after a batch of writes has been posted,
-and also when we may have to wait for a page latch! Otherwise a deadlock
-of threads can occur. */
+/** Flushes possible buffered writes from the doublewrite memory buffer
+segment of a buffer pool instance to disk, and also wakes up the aio thread
+if simulated aio is used. It is very important to call this function after
+a batch of writes has been posted, and also when we may have to wait for a
+page latch! Otherwise a deadlock of threads can occur.
+@param[in]	instance_no	buffer pool instance whose doublewrite
+				batch segment is to be flushed */
 void
-buf_dblwr_flush_buffered_writes(void);
-/*=================================*/
+buf_dblwr_flush_buffered_writes(ulint instance_no);
 /********************************************************************//**
 Writes a page to the doublewrite buffer on disk, sync it, then write
 the page to the datafile and sync the datafile. This function is used
@@ -122,19 +122,40 @@ buf_dblwr_write_single_page(
 	buf_page_t*	bpage,	/*!< in: buffer block to write */
 	bool		sync);	/*!< in: true if sync IO requested */
 
+/** Minimum number of slots in a segment of the batch flush area of the
+doublewrite buffer. Each batch costs a doublewrite write and two fsyncs,
+so smaller segments would cost more than the parallelism gains. */
+#define BUF_DBLWR_MIN_SEG_SLOTS	16
+
+/** A segment of the batch flush area of the doublewrite buffer. The
+batch slots are divided between the buffer pool instances so that the
+page cleaner threads can fill, write and sync them independently. */
+struct buf_dblwr_seg_t{
+	ib_mutex_t	mutex;	/*!< mutex protecting the fields below
+				and the slots of this segment */
+	ulint		first_slot;/*!< first slot of this segment in
+				write_buf and buf_block_arr */
+	ulint		n_slots;/*!< number of slots in this segment */
+	ulint		first_free;/*!< first free position in this
+				segment, relative to first_slot */
+	ulint		b_reserved;/*!< number of slots currently reserved
+				for batch flush. */
+	os_event_t	b_event;/*!< event where threads wait for a
+				batch flush to end. */
+	bool		batch_running;/*!< set to true if currently a batch
+				is being written from this segment */
+};
+
 /** Doublewrite control struct */
 struct buf_dblwr_t{
-	ib_mutex_t	mutex;	/*!< mutex protecting the first_free
-				field and write_buf */
+	ib_mutex_t	mutex;	/*!< mutex protecting the single page
+				flush slots */
 	ulint		block1;	/*!< the page number of the first
 				doublewrite block (64 pages) */
 	ulint		block2;	/*!< page number of the second block */
-	ulint		first_free;/*!< first free position in write_buf
-				measured in units of UNIV_PAGE_SIZE */
-	ulint		b_reserved;/*!< number of slots currently reserved
-				for batch flush. */
-	os_event_t	b_event;/*!< event where threads wait for a
-				batch flush to end. */
+	buf_dblwr_seg_t*
+			segs;	/*!< batch flush segments */
+	ulint		n_segs;	/*!< number of batch flush segments */
 	ulint		s_reserved;/*!< number of slots currently
 				reserved for single page flushes. */
 	os_event_t	s_event;/*!< event where threads wait for a
@@ -142,9 +163,6 @@ struct buf_dblwr_t{
 	bool*		in_use;	/*!< flag used to indicate if a slot is
 				in use. Only used for single page
 				flushes. */
-	bool		batch_running;/*!< set to TRUE if currently a batch
-				is being written from the doublewrite
-				buffer. */
 	byte*		write_buf;/*!< write buffer used in writing to the
 				doublewrite buffer, aligned to an
 				address divisible by UNIV_PAGE_SIZE
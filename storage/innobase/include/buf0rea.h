@@ -49,12 +49,23 @@ released by the i/o-handler thread.
 @param[in]	page_id		page id
 @param[in]	page_size	page size
 @param[in]	sync		true if synchronous aio is desired
+@param[in]	load		true if buf_load() requests the read; it is
+then counted in buf_load_n_pending_reads until it completes
 @return TRUE if page has been read in, FALSE in case of failure */
 ibool
 buf_read_page_background(
 	const page_id_t&	page_id,
 	const page_size_t&	page_size,
-	bool			sync);
+	bool			sync,
+	bool			load);
+
+/** Note that the read of a page has ended, successfully or not. If the
+read was requested by buf_load(), it is no longer counted in
+buf_load_n_pending_reads. The caller must hold the block mutex.
+@param[in,out]	bpage	page whose read has ended */
+void
+buf_read_page_end(
+	buf_page_t*	bpage);
 
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
@@ -154,6 +165,12 @@ invoked */
 #define BUF_READ_IBUF_PAGES_ONLY	131
 /** read any page */
 #define BUF_READ_ANY_PAGE		132
+/** read any page, on behalf of buf_load() */
+#define BUF_READ_LOAD_PAGE		133
 /* @} */
 
+/** Number of page reads requested by buf_load() that have not
+completed yet */
+extern ulint	buf_load_n_pending_reads;
+
 #endif
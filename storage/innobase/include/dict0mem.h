@@ -692,7 +692,8 @@ public:
 		sz_of_offsets(),
 		fixed_len_key(),
 		offsets_cached(),
-		key_has_null_cols()
+		key_has_null_cols(),
+		n_memcmp_fields()
 	{
 		/* Do Nothing. */
 	}
@@ -716,6 +717,11 @@ public:
 	/** If true, then key part can have columns that can take
 	NULL values. */
 	bool		key_has_null_cols;
+
+	/** Number of leading key fields that are NOT NULL, of fixed
+	length and ordered by memcmp(). page_cur_search_with_match()
+	compares them without rec_get_offsets() and type dispatch. */
+	ulint		n_memcmp_fields;
 };
 
 /** Cache position of last inserted or selected record by caching record
@@ -893,6 +899,11 @@ struct dict_index_t{
 	ulint		stat_n_leaf_pages;
 				/*!< approximate number of leaf pages in the
 				index tree */
+	ib_uint64_t	stat_modified_counter;
+				/*!< number of changes to the entries of
+				the index since dict_stats_analyze_index()
+				last ran; not protected by any latch, like
+				dict_table_t::stat_modified_counter */
 	/* @} */
 	last_ops_cur_t*	last_ins_cur;
 				/*!< cache the last insert position.
@@ -1520,7 +1531,7 @@ struct dict_table_t {
 	ulong					n_waiting_or_granted_auto_inc_locks;
 
 	/** The transaction that currently holds the the AUTOINC lock on this
-	table. Protected by lock_sys->mutex. */
+	table. Protected by lock_sys->latch. */
 	const trx_t*				autoinc_trx;
 
 	/* @} */
@@ -1541,7 +1552,9 @@ struct dict_table_t {
 
 	/** Count of the number of record locks on this table. We use this to
 	determine whether we can evict the table from the dictionary cache.
-	It is protected by lock_sys->mutex. */
+	It is protected by lock_sys->latch in exclusive mode, except that
+	record locks created under a record lock shard increment it
+	atomically. */
 	ulint					n_rec_locks;
 
 #ifndef UNIV_DEBUG
@@ -1553,7 +1566,7 @@ private:
 	ulint					n_ref_count;
 
 public:
-	/** List of locks on the table. Protected by lock_sys->mutex. */
+	/** List of locks on the table. Protected by lock_sys->latch. */
 	table_lock_list_t			locks;
 
 	/** Timestamp of the last modification of this table. */
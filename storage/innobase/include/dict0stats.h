@@ -38,6 +38,11 @@ enum dict_stats_upd_option_t {
 				storage, if the persistent storage is
 				not present then emit a warning and
 				fall back to transient stats */
+	DICT_STATS_RECALC_PERSISTENT_CHANGED,/* like
+				DICT_STATS_RECALC_PERSISTENT, but only
+				the indexes that have been modified since
+				their statistics were last calculated are
+				analyzed again */
 	DICT_STATS_RECALC_TRANSIENT,/* (re) calculate the statistics
 				using an imprecise quick algo
 				without saving the results
@@ -393,6 +393,14 @@ extern ulong		fts_max_total_cache_size;
 /** Variable specifying the FTS result cache limit for each query */
 extern ulong		fts_result_cache_limit;
 
+/** Variable specifying the maximum size of the decoded posting lists
+cached for each table */
+extern ulong		fts_posting_cache_size;
+
+/** Variable specifying the number of threads that read the posting lists
+of the terms of a query */
+extern ulong		fts_query_pll_degree;
+
 /** Variable specifying the maximum FTS max token size */
 extern ulong		fts_max_token_size;
 
@@ -501,6 +501,68 @@ fts_cache_find_word(
 			text)		/*!< in: word to search for */
 	__attribute__((warn_unused_result));
 
+/** Empty fts_cache_t::postings, because the FTS INDEX tables were modified.
+@param[in,out]	cache		FTS cache */
+void
+fts_cache_postings_clear(
+	fts_cache_t*	cache);
+
+/** Remove the decoded posting list of a word from fts_cache_t::postings,
+because the word's rows in the FTS INDEX table were modified. The caller
+must hold cache->lock in X mode.
+@param[in,out]	cache		FTS cache
+@param[in]	index		FTS index
+@param[in]	charset		charset of the FTS index
+@param[in]	word		modified word */
+void
+fts_cache_postings_invalidate(
+	fts_cache_t*		cache,
+	const dict_index_t*	index,
+	CHARSET_INFO*		charset,
+	const fts_string_t*	word);
+
+/** Look up the decoded posting list of a word in fts_cache_t::postings.
+The caller must hold cache->lock in S or X mode.
+@param[in,out]	cache		FTS cache
+@param[in]	index		FTS index
+@param[in]	charset		charset of the FTS index
+@param[in]	word		word to look up
+@return posting list, to be released with fts_cache_postings_release(),
+or NULL if it is not cached */
+fts_postings_t*
+fts_cache_postings_get(
+	fts_cache_t*		cache,
+	const dict_index_t*	index,
+	CHARSET_INFO*		charset,
+	const fts_string_t*	word)
+	__attribute__((warn_unused_result));
+
+/** Add a decoded posting list to fts_cache_t::postings, unless the
+FTS INDEX tables were modified since it was read, another thread
+added it first, or it is larger than fts_posting_cache_size. The oldest
+posting lists that were not accessed since the eviction last passed
+them are evicted to make room. The caller must hold cache->lock in
+X mode.
+@param[in,out]	cache		FTS cache
+@param[in,out]	postings	posting list, with n_ref == 1
+@param[in]	version		fts_cache_t::postings_version before
+				the posting list was read */
+void
+fts_cache_postings_add(
+	fts_cache_t*	cache,
+	fts_postings_t*	postings,
+	ib_uint64_t	version);
+
+/** Release a posting list returned by fts_cache_postings_get() or
+added with fts_cache_postings_add(). The caller must hold cache->lock
+in S or X mode, so that postings->cached cannot change.
+@param[in]	cache		FTS cache
+@param[in,out]	postings	posting list */
+void
+fts_cache_postings_release(
+	const fts_cache_t*	cache,
+	fts_postings_t*		postings);
+
 /******************************************************************//**
 Check cache for deleted doc id.
 @return TRUE if deleted */
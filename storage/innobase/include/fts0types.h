@@ -126,6 +126,55 @@ struct fts_sync_t {
         ib_time_t	start_time;	/*!< SYNC start time */
 };
 
+/** A document in a decoded posting list */
+struct fts_posting_t {
+	doc_id_t	doc_id;		/*!< Document id */
+	ulint		pos;		/*!< Offset of the first word position
+					in fts_postings_t::positions */
+	ulint		n_pos;		/*!< Number of word positions */
+};
+
+/** A row of the FTS INDEX table in a decoded posting list */
+struct fts_postings_node_t {
+	doc_id_t	first_doc_id;	/*!< First document id in ilist */
+	doc_id_t	last_doc_id;	/*!< Last document id in ilist */
+	ulint		first;		/*!< Offset of the first document
+					in fts_postings_t::docs */
+	ulint		n_docs;		/*!< Number of documents in ilist */
+};
+
+/** The documents and word positions of a word, decoded from the ilists
+of the word's rows in the FTS INDEX table. Kept in fts_cache_t::postings
+until the FTS INDEX tables are modified by SYNC or OPTIMIZE. The
+instance and all its arrays are one ut_malloc() block. */
+struct fts_postings_t {
+	index_id_t	index_id;	/*!< Id of the FTS index */
+	CHARSET_INFO*	charset;	/*!< Charset of the FTS index */
+	fts_string_t	word;		/*!< The word */
+	ulint		doc_count;	/*!< Sum of DOC_COUNT of the rows */
+	ulint		n_nodes;	/*!< Number of rows */
+	fts_postings_node_t*
+			nodes;		/*!< The rows, in the order of
+					FIRST_DOC_ID */
+	fts_posting_t*	docs;		/*!< Documents of the rows, ascending
+					doc id within each row */
+	ulint*		positions;	/*!< Word positions of the documents */
+	ulint		size;		/*!< Size of the allocation in bytes */
+	ulint		n_ref;		/*!< Number of threads using the
+					instance; modified atomically with
+					fts_cache_t::lock held in S or X mode */
+	bool		cached;		/*!< Whether the instance is in
+					fts_cache_t::postings; covered by
+					fts_cache_t::lock */
+	bool		accessed;	/*!< Whether the instance was looked
+					up since it was last passed by the
+					eviction; set with fts_cache_t::lock
+					held in S or X mode */
+
+	UT_LIST_NODE_T(fts_postings_t)
+			LRU;		/*!< List of cached posting lists */
+};
+
 /** The cache for the FTS system. It is a memory-based inverted index
 that new entries are added to, until it grows over the configured maximum
 size, at which time its contents are written to the INDEX table. */
@@ -190,6 +239,25 @@ struct fts_cache_t {
 
 	fts_stopword_t	stopword_info;	/*!< Cached stopwords for the FTS */
 	mem_heap_t*	cache_heap;	/*!< Cache Heap */
+
+	ib_rbt_t*	postings;	/*!< Decoded posting lists of words
+					read from the FTS INDEX tables, indexed
+					by (index id, word), cells are
+					fts_postings_t*. Covered by lock */
+
+	UT_LIST_BASE_NODE_T(fts_postings_t)
+			postings_LRU;	/*!< The posting lists in postings,
+					most recently added first; the
+					eviction gives the accessed ones a
+					second chance */
+
+	ulint		postings_size;	/*!< Total size of the posting lists
+					in postings; at most
+					fts_posting_cache_size */
+
+	ib_uint64_t	postings_version;/*!< Incremented when postings is
+					emptied because the FTS INDEX tables
+					were modified */
 };
 
 /** Columns of the FTS auxiliary INDEX table */
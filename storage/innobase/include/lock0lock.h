@@ -583,6 +583,32 @@ lock_rec_hash(
 	ulint	space,	/*!< in: space */
 	ulint	page_no);/*!< in: page number */
 
+struct lock_rec_shard_t;
+
+/** Get the record lock shard of a page.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number
+@return the shard that protects the record locks on the page */
+UNIV_INLINE
+lock_rec_shard_t*
+lock_rec_get_shard(
+	ulint	space,
+	ulint	page_no);
+
+#ifdef UNIV_DEBUG
+/** Check if the record locks on a page may be accessed: either
+lock_sys->latch is held in exclusive mode, or it is held in shared mode
+together with the record lock shard of the page.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number
+@return true if the record locks of the page are protected */
+UNIV_INLINE
+bool
+lock_rec_page_own(
+	ulint	space,
+	ulint	page_no);
+#endif /* UNIV_DEBUG */
+
 /*************************************************************//**
 Get the lock hash table */
 UNIV_INLINE
@@ -692,7 +718,7 @@ lock_print_info_all_transactions(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -701,7 +727,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -810,6 +836,17 @@ DECLARE_THREAD(lock_wait_timeout_thread)(
 	void*	arg);	/*!< in: a dummy parameter required by
 			os_thread_create */
 
+/** Checks whether a transaction that is waiting for a lock is involved in
+a deadlock, and resolves it. This is how deadlocks are found when
+innodb_deadlock_detect_async is set: lock waits are enqueued without a
+deadlock check and the lock wait timeout thread calls this for every
+suspended transaction. If the transaction itself is chosen as the victim,
+its lock wait is cancelled and it will return DB_DEADLOCK.
+@param[in,out]	trx	transaction waiting for a lock */
+void
+lock_wait_check_deadlock(
+	trx_t*	trx);
+
 /********************************************************************//**
 Releases a user OS thread waiting for a lock to be released, if the
 thread is already suspended. */
@@ -972,10 +1009,43 @@ struct lock_op_t{
 
 typedef ib_mutex_t LockMutex;
 
-/** The lock system struct */
-struct lock_sys_t{
+/** Number of record lock shards */
+#define LOCK_REC_N_SHARDS	64
+
+/** A record lock shard. It protects the cells of lock_sys->rec_hash
+whose index modulo LOCK_REC_N_SHARDS is the number of the shard. */
+struct lock_rec_shard_t{
 	LockMutex	mutex;			/*!< Mutex protecting the
+						record locks of the shard
+						while lock_sys->latch is
+						held in shared mode */
+	byte		pad[CACHE_LINE_SIZE];	/*!< keeps the mutexes of
+						different shards apart */
+};
+
+/** The lock system struct.
+
+lock_sys->latch held in exclusive mode (lock_mutex_enter()) protects all
+the locks, as the single lock system mutex did before. The common case of
+setting a record lock, when the lock queue of the page does not require
+waiting (lock_rec_lock_fast()), instead holds lock_sys->latch in shared
+mode and the mutex of the record lock shard of the page, so that
+transactions locking records on pages of different shards do not
+serialize on one latch.
+
+Latching order: lock_sys->latch, then at most one
+lock_rec_shard_t::mutex, then trx_t::mutex. Holding a shard allows
+looking up and adding record locks in the hash cells of that shard, and
+changing the trx_t::lock fields of the own transaction under its
+trx_t::mutex. Anything else, for example waiting, releasing or moving
+locks, table locks, implicit to explicit lock conversion or deadlock
+checks, requires lock_sys->latch in exclusive mode. */
+struct lock_sys_t{
+	rw_lock_t	latch;			/*!< latch protecting the
 						locks */
+	lock_rec_shard_t
+			rec_shards[LOCK_REC_N_SHARDS];
+						/*!< record lock shards */
 	hash_table_t*	rec_hash;		/*!< hash table of the record
 						locks */
 	hash_table_t*	prdt_hash;		/*!< hash table of the predicate
@@ -996,7 +1066,7 @@ struct lock_sys_t{
 						/*!< TRUE if rollback of all
 						recovered transactions is
 						complete. Protected by
-						lock_sys->mutex */
+						lock_sys->latch */
 
 	ulint		n_lock_max_wait_time;	/*!< Max wait time */
 
@@ -1053,21 +1123,40 @@ lock_rec_trx_wait(
 /** The lock system */
 extern lock_sys_t*	lock_sys;
 
-/** Test if lock_sys->mutex can be acquired without waiting. */
+/** Test if lock_sys->latch can be acquired in exclusive mode without
+waiting.
+@return 0 if the latch was acquired */
 #define lock_mutex_enter_nowait() 		\
-	(lock_sys->mutex.trylock(__FILE__, __LINE__))
+	(!rw_lock_x_lock_nowait(&lock_sys->latch))
 
-/** Test if lock_sys->mutex is owned. */
-#define lock_mutex_own() (lock_sys->mutex.is_owned())
+/** Test if lock_sys->latch is owned in exclusive mode. */
+#define lock_mutex_own() (rw_lock_own(&lock_sys->latch, RW_LOCK_X))
 
-/** Acquire the lock_sys->mutex. */
+/** Acquire lock_sys->latch in exclusive mode. */
 #define lock_mutex_enter() do {			\
-	mutex_enter(&lock_sys->mutex);		\
+	rw_lock_x_lock(&lock_sys->latch);	\
 } while (0)
 
-/** Release the lock_sys->mutex. */
+/** Release lock_sys->latch from exclusive mode. */
 #define lock_mutex_exit() do {			\
-	lock_sys->mutex.exit();			\
+	rw_lock_x_unlock(&lock_sys->latch);	\
+} while (0)
+
+/** Acquire lock_sys->latch in shared mode and the record lock shard of
+a page.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number */
+#define lock_rec_shard_enter(space, page_no) do {			\
+	rw_lock_s_lock(&lock_sys->latch);				\
+	mutex_enter(&lock_rec_get_shard(space, page_no)->mutex);	\
+} while (0)
+
+/** Release the record lock shard of a page and lock_sys->latch.
+@param[in]	space	tablespace id
+@param[in]	page_no	page number */
+#define lock_rec_shard_exit(space, page_no) do {			\
+	lock_rec_get_shard(space, page_no)->mutex.exit();		\
+	rw_lock_s_unlock(&lock_sys->latch);				\
 } while (0)
 
 /** Test if lock_sys->wait_mutex is owned. */
@@ -64,6 +64,12 @@ extern log_checksum_func_t log_checksum_algorithm_ptr;
 /** Maximum number of log groups in log_group_t::checkpoint_buf */
 #define LOG_MAX_N_GROUPS	32
 
+/** Number of events on which the threads in log_wait_up_to() sleep.
+The waiters are distributed over them by the log block of the lsn that
+they wait for, so that the log_flusher thread only wakes up the threads
+whose lsn has been reached. */
+#define LOG_N_WAIT_EVENTS	64
+
 /*******************************************************************//**
 Calculates where in log files we find a specified lsn.
 @return log file number */
@@ -131,6 +137,30 @@ log_write_low(
 /*==========*/
 	const byte*	str,		/*!< in: string */
 	ulint		str_len);	/*!< in: string length */
+/** Reserve space in the log buffer for a string that will be copied
+there by log_buffer_copy() after the log mutex has been released. Every
+call must be paired with a call to log_buffer_copy_end(). It is assumed
+that the caller holds the log mutex.
+@param[in]	str_len	string length
+@return start of the reserved area in the log buffer */
+byte*
+log_reserve_low(
+	ulint	str_len);
+/** Copy a string to an area of the log buffer that was reserved by
+log_reserve_low(). This does not require the log mutex.
+@param[in,out]	buf	position in the reserved area
+@param[in]	str	string
+@param[in]	str_len	string length
+@return position in the reserved area after the string */
+byte*
+log_buffer_copy(
+	byte*		buf,
+	const byte*	str,
+	ulint		str_len);
+/** Note that a string has been copied to the area of the log buffer that
+was reserved by log_reserve_low(). */
+void
+log_buffer_copy_end(void);
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -197,6 +227,19 @@ log_write_up_to(
 	bool	flush_to_disk);
 			/*!< in: true if we want the written log
 			also to be flushed to disk */
+/** Wait until the log has been written to the log file up to a given
+log entry (such as that of a transaction commit). The write, and the
+flush if requested, are done by the log_flusher thread, which covers all
+the waiting threads at once; if that thread is not running, this
+invokes log_write_up_to().
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system */
+void
+log_wait_up_to(
+	lsn_t	lsn,
+	bool	flush_to_disk);
 /** write to the log file up to the last log entry.
 @param[in]	sync	whether we want the written log
 also to be flushed to disk. */
@@ -719,6 +762,13 @@ struct log_t{
 					groups */
 	volatile bool	is_extending;	/*!< this is set to true during extend
 					the log buffer size */
+	volatile ulint	n_pending_copies;/*!< number of areas reserved in
+					the log buffer by log_reserve_low()
+					whose contents have not been copied
+					yet; incrementing is protected by
+					the log mutex. The log buffer is not
+					written or moved before this drops
+					to zero. */
 	lsn_t		write_lsn;	/*!< last written lsn */
 	ulint		write_end_offset;/*!< the data in buffer has
 					been written up to this offset
@@ -741,6 +791,17 @@ struct log_t{
 					owning the log mutex, but NOTE that
 					to set this event, the
 					thread MUST own the log mutex! */
+	os_event_t	flusher_event;	/*!< set to wake up the log_flusher
+					thread when a thread starts to wait
+					in log_wait_up_to() */
+	volatile bool	flusher_flush_requested;
+					/*!< set when a thread waiting in
+					log_wait_up_to() needs the log to be
+					flushed to disk, not only written */
+	os_event_t	wait_events[LOG_N_WAIT_EVENTS];
+					/*!< events on which the threads in
+					log_wait_up_to() sleep, see
+					log_wait_event() */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
@@ -803,6 +864,20 @@ struct log_t{
 	/* @} */
 };
 
+/** Flag indicating if the log_flusher thread is active. */
+extern volatile bool	log_flusher_thread_active;
+
+/******************************************************************//**
+The log_flusher thread writes and flushes the log on behalf of the
+threads waiting in log_wait_up_to().
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg);		/*!< in: a dummy parameter required by
+				os_thread_create */
+
 /** Test if flush order mutex is owned. */
 #define log_flush_order_mutex_own()			\
 	mutex_own(&log_sys->log_flush_order_mutex)
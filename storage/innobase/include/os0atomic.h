@@ -265,6 +265,7 @@ Returns the old value of *ptr, atomically sets *ptr to new_val */
 # define HAVE_MEMORY_BARRIER
 # define os_rmb	__atomic_thread_fence(__ATOMIC_ACQUIRE)
 # define os_wmb	__atomic_thread_fence(__ATOMIC_RELEASE)
+# define os_mb	__atomic_thread_fence(__ATOMIC_SEQ_CST)
 # define IB_MEMORY_BARRIER_STARTUP_MSG \
 	"GCC builtin __atomic_thread_fence() is used for memory barrier"
 
@@ -272,6 +273,7 @@ Returns the old value of *ptr, atomically sets *ptr to new_val */
 # define HAVE_MEMORY_BARRIER
 # define os_rmb	__sync_synchronize()
 # define os_wmb	__sync_synchronize()
+# define os_mb	__sync_synchronize()
 # define IB_MEMORY_BARRIER_STARTUP_MSG \
 	"GCC builtin __sync_synchronize() is used for memory barrier"
 
@@ -280,20 +282,24 @@ Returns the old value of *ptr, atomically sets *ptr to new_val */
 # include <mbarrier.h>
 # define os_rmb	__machine_r_barrier()
 # define os_wmb	__machine_w_barrier()
+# define os_mb	__machine_rw_barrier()
 # define IB_MEMORY_BARRIER_STARTUP_MSG \
 	"Solaris memory ordering functions are used for memory barrier"
 
 #elif defined(HAVE_WINDOWS_MM_FENCE) && defined(_WIN64)
 # define HAVE_MEMORY_BARRIER
 # include <mmintrin.h>
+# include <emmintrin.h>
 # define os_rmb	_mm_lfence()
 # define os_wmb	_mm_sfence()
+# define os_mb	_mm_mfence()
 # define IB_MEMORY_BARRIER_STARTUP_MSG \
 	"_mm_lfence() and _mm_sfence() are used for memory barrier"
 
 #else
 # define os_rmb
 # define os_wmb
+# define os_mb
 # define IB_MEMORY_BARRIER_STARTUP_MSG \
 	"Memory barrier is not used"
 #endif
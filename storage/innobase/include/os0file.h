@@ -182,7 +182,14 @@ struct Compression {
 		ZLIB = 1,
 
 		/** Use LZ4 faster variant, usually lower compression. */
-		LZ4 = 2
+		LZ4 = 2,
+
+		/** Use LZ4 high compression variant, slower compression
+		but decompression as fast as LZ4. The output is LZ4 data,
+		and the pages are marked as LZ4, see stored_type(). This
+		is only a choice of compression level; it is never
+		written to disk. */
+		LZ4HC = 3
 	};
 
 	/** Compressed page meta-data */
@@ -218,6 +225,7 @@ struct Compression {
 		case NONE:
 		case ZLIB:
 		case LZ4:
+		case LZ4HC:
 
 		default:
 			ut_error;
@@ -250,6 +258,13 @@ struct Compression {
         static const char* to_string(Type type)
 		__attribute__((warn_unused_result));
 
+	/** Get the algorithm that is written to the header of the pages
+	compressed with an algorithm.
+	@param[in]	type		compression algorithm
+	@return the algorithm that decompresses the pages */
+	static Type stored_type(Type type)
+		__attribute__((warn_unused_result));
+
         /** Convert the meta data to a std::string.
         @param[in]      meta		Page Meta data
         @return the string representation */
@@ -269,6 +284,42 @@ struct Compression {
 	static bool is_none(const char* algorithm)
 		__attribute__((warn_unused_result));
 
+	/** Compress data with an algorithm.
+	@param[in]	type		compression algorithm, not NONE
+	@param[in]	level		compression level, interpreted by
+					the algorithm (innodb_compression_level)
+	@param[in]	src		data to compress
+	@param[in]	src_len		length of src in bytes
+	@param[out]	dst		compressed data
+	@param[in]	dst_len		size of dst in bytes
+	@return length of the compressed data, or 0 if it did not fit
+	in dst_len bytes */
+	static ulint compress(
+		Type		type,
+		ulint		level,
+		const byte*	src,
+		ulint		src_len,
+		byte*		dst,
+		ulint		dst_len)
+		__attribute__((warn_unused_result));
+
+	/** Decompress data that was compressed with compress().
+	@param[in]	type		compression algorithm, not NONE
+	@param[in]	safe		whether src may be malformed
+	@param[in]	src		compressed data
+	@param[in]	src_len		length of src in bytes
+	@param[out]	dst		decompressed data
+	@param[in]	dst_len		length of the decompressed data
+	@return whether the data was decompressed */
+	static bool decompress(
+		Type		type,
+		bool		safe,
+		const byte*	src,
+		ulint		src_len,
+		byte*		dst,
+		ulint		dst_len)
+		__attribute__((warn_unused_result));
+
 	/** Decompress the page data contents. Page type must be
 	FIL_PAGE_COMPRESSED, if not then the source contents are
 	left unchanged and DB_SUCCESS is returned.
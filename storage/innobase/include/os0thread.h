@@ -35,6 +35,11 @@ can wait inside InnoDB */
 
 #define	OS_THREAD_MAX_N		srv_max_n_threads
 
+/* Maximum number of threads that can be started through OSThreadGroup
+at any one time; they are included in OS_THREAD_MAX_N */
+
+#define	OS_THREAD_MAX_N_WORKERS	256
+
 /* Possible fixed priorities for threads */
 #define OS_THREAD_PRIORITY_NONE		100
 #define OS_THREAD_PRIORITY_BACKGROUND	1
@@ -160,6 +165,73 @@ bool
 os_thread_active();
 /*==============*/
 
+typedef struct os_event* os_event_t;
+
+/** Worker threads that a thread starts for one task and then waits
+for. The threads are reserved from OS_THREAD_MAX_N_WORKERS. When no more
+threads can be reserved, start() fails and the starting thread is
+expected to do the work itself. */
+class OSThreadGroup {
+public:
+	OSThreadGroup()
+		:
+		m_n_started(),
+		m_n_running(),
+		m_event()
+	{
+	}
+
+	/** Wait for the threads that are still running. */
+	~OSThreadGroup();
+
+	/** Start a thread of the group.
+	@param[in]	func	function from which to start; it must
+	end by calling exit()
+	@param[in]	arg	argument of func
+	@return true if the thread was started, false if no more
+	threads can be reserved */
+	template <typename Func>
+	bool start(Func func, void* arg)
+	{
+		if (!reserve()) {
+			return(false);
+		}
+
+		os_thread_create(func, arg, NULL);
+
+		return(true);
+	}
+
+	/** Exit the calling thread of the group. This must be the last
+	access of the thread to data that the starting thread may free
+	after join(). */
+	void exit()
+		UNIV_COLD __attribute__((noreturn));
+
+	/** Wait until every thread that was started has called exit(),
+	and return the threads to OS_THREAD_MAX_N_WORKERS. */
+	void join();
+
+private:
+	/** Reserve a thread in OS_THREAD_MAX_N_WORKERS.
+	@return false if all the threads are in use */
+	bool reserve();
+
+	/** Number of threads that were started and not joined yet */
+	ulint		m_n_started;
+
+	/** Number of threads that have not called exit() yet; protected
+	by thread_mutex */
+	ulint		m_n_running;
+
+	/** Set when m_n_running drops to 0 */
+	os_event_t	m_event;
+
+	/* Disable copying */
+	OSThreadGroup(const OSThreadGroup&);
+	OSThreadGroup& operator=(const OSThreadGroup&);
+};
+
 #ifndef UNIV_NONINL
 #include "os0thread.ic"
 #endif
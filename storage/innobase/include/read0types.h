@@ -318,6 +318,10 @@ private:
 	they can be removed in purge if not needed by other views */
 	trx_id_t	m_low_limit_no;
 
+	/** Value of trx_sys_t::rw_trx_ids_version when the snapshot was
+	taken. While it is unchanged, the snapshot is still current. */
+	ulint		m_version;
+
 	/** AC-NL-RO transaction view that has been "closed". */
 	bool		m_closed;
 
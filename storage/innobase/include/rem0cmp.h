@@ -43,6 +43,65 @@ cmp_cols_are_equal(
 	const dict_col_t*	col2,	/*!< in: column 2 */
 	ibool			check_charsets);
 					/*!< in: whether to check charsets */
+/** Determine if values of a data type are ordered as their stored bytes,
+so that they can be compared with memcmp().
+@param[in]	mtype	main type
+@param[in]	prtype	precise type
+@return whether the type is ordered by memcmp() */
+bool
+cmp_type_is_memcmp(
+	ulint	mtype,
+	ulint	prtype)
+	__attribute__((warn_unused_result));
+
+/** Maximum number of bytes in a cmp_memcmp_key_t */
+#define CMP_MEMCMP_KEY_MAX		128
+
+/** Maximum number of fields in a cmp_memcmp_key_t */
+#define CMP_MEMCMP_KEY_MAX_FIELDS	16
+
+/** The leading fields of a search tuple that are compared to B-tree
+records with memcmp(), see rec_cache_t::n_memcmp_fields. The fields
+are concatenated as they are stored at the start of an index record. */
+struct cmp_memcmp_key_t {
+	/** Number of fields in key, or 0 if the search tuple
+	must be compared with cmp_dtuple_rec_with_match() only */
+	ulint	n_fields;
+	/** End offset of each field in key */
+	ulint	field_end[CMP_MEMCMP_KEY_MAX_FIELDS];
+	/** The concatenated fields */
+	byte	key[CMP_MEMCMP_KEY_MAX];
+};
+
+/** Copy the leading fields of a search tuple that can be compared with
+memcmp() to a search key.
+@param[out]	key	search key
+@param[in]	dtuple	search tuple
+@param[in]	index	B-tree index */
+void
+cmp_memcmp_key_init(
+	cmp_memcmp_key_t*	key,
+	const dtuple_t*		dtuple,
+	const dict_index_t*	index);
+
+/** Compare the leading fields of a search tuple to a physical record.
+@param[in]	key		search key, with key->n_fields > 0
+@param[in]	rec		B-tree record
+@param[in]	comp		nonzero=compact record format
+@param[in,out]	matched_fields	number of completely matched fields;
+must be less than key->n_fields
+@return the comparison result of key and rec
+@retval 0 if the key->n_fields leading fields are equal
+@retval negative if key is less than rec
+@retval positive if key is greater than rec */
+int
+cmp_memcmp_key_rec_with_match(
+	const cmp_memcmp_key_t*	key,
+	const rec_t*		rec,
+	ulint			comp,
+	ulint*			matched_fields)
+	__attribute__((nonnull, warn_unused_result));
+
 /** Compare two data fields.
 @param[in] mtype main type
 @param[in] prtype precise type
@@ -60,6 +60,11 @@ whose maximum size is the same as the minimum size of
 row_merge_block_t. */
 typedef byte	mrec_buf_t[UNIV_PAGE_SIZE_MAX];
 
+/** Maximum number of runs that row_merge_sort() merges in one go,
+see innodb_sort_merge_ways. Each run needs a row_merge_block_t
+and an mrec_buf_t. */
+#define ROW_MERGE_MAX_WAYS	64
+
 /** @brief Merge record in row_merge_block_t.
 
 The format is the same as a record in ROW_FORMAT=COMPACT with the
@@ -355,8 +360,10 @@ row_merge_file_create(
 	merge_file_t*	merge_file)	/*!< out: merge file structure */
 	__attribute__((nonnull));
 
-/** Merge disk files.
-@param[in]	trx	transaction
+/** Merge disk files. Up to innodb_sort_merge_ways runs are merged
+in each pass; the buffers for merging more than two runs at a time are
+allocated here.
+@param[in]	trx	transaction, or NULL in a merge sort thread
 @param[in]	dup	descriptor of index being created
 @param[in,out]	file	file containing index entries
 @param[in,out]	block	3 buffers
@@ -364,6 +371,8 @@ row_merge_file_create(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in]	aborted	flag that the ALTER TABLE thread sets to stop a merge
+sort thread, or NULL to check whether trx was interrupted instead
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -372,7 +381,8 @@ row_merge_sort(
 	merge_file_t*		file,
 	row_merge_block_t*	block,
 	int*			tmpfd,
-	ut_stage_alter_t*	stage = NULL);
+	ut_stage_alter_t*	stage = NULL,
+	const volatile bool*	aborted = NULL);
 
 /*********************************************************************//**
 Allocate a sort buffer.
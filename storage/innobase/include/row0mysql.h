@@ -645,7 +645,15 @@ struct mysql_row_templ_t {
 	ulint	is_virtual;		/*!< if a column is a virtual column */
 };
 
+/* Number of rows fetched in the first batch into fetch_cache */
 #define MYSQL_FETCH_CACHE_SIZE		8
+/* Maximum number of rows fetched in one batch into fetch_cache; every
+full batch doubles the batch size up to this many rows, or as many rows
+as fit in MYSQL_FETCH_CACHE_MAX_BYTES, whichever is smaller */
+#define MYSQL_FETCH_CACHE_MAX_SIZE	128
+/* Memory budget of fetch_cache for rows that are wider than
+MYSQL_FETCH_CACHE_MAX_BYTES / MYSQL_FETCH_CACHE_MAX_SIZE bytes */
+#define MYSQL_FETCH_CACHE_MAX_BYTES	UNIV_PAGE_SIZE
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
 
@@ -822,7 +830,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte*		fetch_cache[MYSQL_FETCH_CACHE_MAX_SIZE];
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
@@ -840,6 +848,12 @@ struct row_prebuilt_t {
 					fetched row in fetch_cache */
 	ulint		n_fetch_cached;	/*!< number of not yet fetched rows
 					in fetch_cache */
+	ulint		fetch_cache_size;/*!< number of rows to fetch into
+					fetch_cache in the current batch;
+					grows while the cursor keeps
+					consuming full batches */
+	ulint		fetch_cache_alloc;/*!< number of allocated
+					fetch_cache[] entries */
 	mem_heap_t*	blob_heap;	/*!< in SELECTS BLOB fields are copied
 					to this heap */
 	mem_heap_t*	old_vers_heap;	/*!< memory heap where a previous
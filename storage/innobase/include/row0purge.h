@@ -85,7 +85,8 @@ struct purge_node_t{
 	/*----------------------*/
 	/* Local storage for this graph node */
 	roll_ptr_t	roll_ptr;/* roll pointer to undo log record */
-	ib_vector_t*    undo_recs;/*!< Undo recs to purge */
+	ulint		n_recs;	/*!< Number of undo records purged by
+				this node in the current batch */
 
 	undo_no_t	undo_no;/*!< undo number of the record */
 
@@ -229,6 +229,8 @@ enum monitor_id_t {
 	MONITOR_LRU_SINGLE_FLUSH_SCANNED_PER_CALL,
 	MONITOR_LRU_SINGLE_FLUSH_FAILURE_COUNT,
 	MONITOR_LRU_GET_FREE_SEARCH,
+	MONITOR_LRU_GET_FREE_SINGLE_FLUSH,
+	MONITOR_LRU_FREE_TARGET,
 	MONITOR_LRU_SEARCH_SCANNED,
 	MONITOR_LRU_SEARCH_SCANNED_NUM_CALL,
 	MONITOR_LRU_SEARCH_SCANNED_PER_CALL,
@@ -307,6 +309,9 @@ enum monitor_id_t {
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
+	MONITOR_PURGE_BATCH_RECORDS,
+	MONITOR_PURGE_BATCH_THREAD_MAX,
+	MONITOR_PURGE_HISTORY_LEN_CHANGE,
 
 	/* Recovery related counters */
 	MONITOR_MODULE_RECOVERY,
@@ -325,6 +330,8 @@ enum monitor_id_t {
 	MONITOR_OVLD_LOG_WRITE_REQUEST,
 	MONITOR_OVLD_LOG_WRITES,
 	MONITOR_OVLD_LOG_PADDED,
+	MONITOR_LOG_FLUSHER_FLUSHES,
+	MONITOR_LOG_FLUSHER_WAITS,
 
 	/* Page Manager related counters */
 	MONITOR_MODULE_PAGE,
@@ -332,6 +339,23 @@ enum monitor_id_t {
 	MONITOR_PAGE_DECOMPRESS,
 	MONITOR_PAD_INCREMENTS,
 	MONITOR_PAD_DECREMENTS,
+	/* Per algorithm transparent page compression counters,
+	grouped by metric in Compression::Type order; pages are
+	decompressed only with the algorithms that are written to the
+	page header */
+	MONITOR_PAGE_CODEC_COMPRESSED_ZLIB,
+	MONITOR_PAGE_CODEC_COMPRESSED_LZ4,
+	MONITOR_PAGE_CODEC_COMPRESSED_LZ4HC,
+	MONITOR_PAGE_CODEC_COMPRESS_TIME_ZLIB,
+	MONITOR_PAGE_CODEC_COMPRESS_TIME_LZ4,
+	MONITOR_PAGE_CODEC_COMPRESS_TIME_LZ4HC,
+	MONITOR_PAGE_CODEC_SAVED_ZLIB,
+	MONITOR_PAGE_CODEC_SAVED_LZ4,
+	MONITOR_PAGE_CODEC_SAVED_LZ4HC,
+	MONITOR_PAGE_CODEC_DECOMPRESSED_ZLIB,
+	MONITOR_PAGE_CODEC_DECOMPRESSED_LZ4,
+	MONITOR_PAGE_CODEC_DECOMPRESS_TIME_ZLIB,
+	MONITOR_PAGE_CODEC_DECOMPRESS_TIME_LZ4,
 
 	/* Index related counters */
 	MONITOR_MODULE_INDEX,
@@ -352,6 +376,7 @@ enum monitor_id_t {
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVED,
 	MONITOR_ADAPTIVE_HASH_ROW_REMOVE_NOT_FOUND,
 	MONITOR_ADAPTIVE_HASH_ROW_UPDATED,
+	MONITOR_ADAPTIVE_HASH_LATCH_WAITS,
 
 	/* Tablespace related counters */
 	MONITOR_MODULE_FIL_SYSTEM,
@@ -410,6 +435,11 @@ enum monitor_id_t {
 	MONITOR_ALTER_TABLE_SORT_FILES,
 	MONITOR_ALTER_TABLE_LOG_FILES,
 
+	/* Index creation merge sort counters */
+	MONITOR_MODULE_DDL_SORT,
+	MONITOR_ALTER_TABLE_SORT_READS,
+	MONITOR_ALTER_TABLE_SORT_WRITES,
+
 	MONITOR_MODULE_ICP,
 	MONITOR_ICP_ATTEMPTS,
 	MONITOR_ICP_NO_MATCH,
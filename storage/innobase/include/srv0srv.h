@@ -215,6 +215,11 @@ extern ibool	srv_locks_unsafe_for_binlog;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** Number of threads used to merge sort secondary index entries in
+index creation */
+extern ulong	srv_sort_pll_degree;
+/** Maximum number of sorted runs merged in one pass of row_merge_sort() */
+extern ulong	srv_sort_merge_ways;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -363,6 +368,7 @@ extern unsigned long long	srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern unsigned long long	srv_stats_persistent_sample_pages;
 extern my_bool			srv_stats_auto_recalc;
+extern ulong			srv_stats_pll_degree;
 
 extern ibool	srv_use_doublewrite_buf;
 extern ulong	srv_doublewrite_batch_size;
@@ -426,6 +432,9 @@ extern const char* srv_io_thread_function[];
 /* the number of purge threads to use from the worker pool (currently 0 or 1) */
 extern ulong srv_n_purge_threads;
 
+/* the number of threads applying redo log records during crash recovery */
+extern ulong srv_n_recv_apply_threads;
+
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
 
@@ -435,6 +444,9 @@ extern ulong srv_sync_array_size;
 /* print all user-level transactions deadlocks to mysqld stderr */
 extern my_bool srv_print_all_deadlocks;
 
+/* leave deadlock detection to the lock wait timeout thread */
+extern my_bool srv_deadlock_detect_async;
+
 extern my_bool	srv_cmp_per_index_enabled;
 
 /** Status variables to be passed to MySQL */
@@ -452,7 +464,9 @@ extern mysql_pfs_key_t	io_ibuf_thread_key;
 extern mysql_pfs_key_t	io_log_thread_key;
 extern mysql_pfs_key_t	io_read_thread_key;
 extern mysql_pfs_key_t	io_write_thread_key;
+extern mysql_pfs_key_t	log_flusher_thread_key;
 extern mysql_pfs_key_t	page_cleaner_thread_key;
+extern mysql_pfs_key_t	recv_apply_thread_key;
 extern mysql_pfs_key_t	recv_writer_thread_key;
 extern mysql_pfs_key_t	srv_error_monitor_thread_key;
 extern mysql_pfs_key_t	srv_lock_timeout_thread_key;
@@ -250,6 +250,7 @@ enum latch_level_t {
 	SYNC_THREADS,
 	SYNC_TRX,
 	SYNC_TRX_SYS,
+	SYNC_LOCK_SYS_SHARD,
 	SYNC_LOCK_SYS,
 	SYNC_LOCK_WAIT_SYS,
 
@@ -360,7 +361,7 @@ enum latch_id_t {
 	LATCH_ID_TRX_POOL,
 	LATCH_ID_TRX_POOL_MANAGER,
 	LATCH_ID_TRX,
-	LATCH_ID_LOCK_SYS,
+	LATCH_ID_LOCK_SYS_SHARD,
 	LATCH_ID_LOCK_SYS_WAIT,
 	LATCH_ID_TRX_SYS,
 	LATCH_ID_SRV_SYS,
@@ -393,6 +394,7 @@ enum latch_id_t {
 	LATCH_ID_INDEX_TREE,
 	LATCH_ID_DICT_TABLE_STATS,
 	LATCH_ID_HASH_TABLE_RW_LOCK,
+	LATCH_ID_LOCK_SYS,
 	LATCH_ID_BUF_CHUNK_MAP_LATCH,
 	LATCH_ID_SYNC_DEBUG_MUTEX,
 	LATCH_ID_TEST_MUTEX,
@@ -414,6 +414,21 @@ struct trx_purge_t{
 	volatile ulint	n_submitted;	/*!< Count of total tasks submitted
 					to the task queue */
 	volatile ulint	n_completed;	/*!< Count of total tasks completed */
+	mem_heap_t*	heap;		/*!< Memory heap for the undo records
+					of the current batch */
+	ib_vector_t*	undo_recs;	/*!< Undo records of the current
+					batch, trx_purge_rec_t. The purge
+					threads take them in order, see
+					next_rec, so that a thread that is
+					done with its records goes on with
+					the ones that the others have not
+					got to yet */
+	volatile ulint	next_rec;	/*!< Number of records that have been
+					taken from undo_recs; may exceed the
+					size of undo_recs by the number of
+					purge threads */
+	ulint		history_len;	/*!< History list length at the
+					start of the previous batch */
 
 	/*------------------------------*/
 	/* The following two fields form the 'purge pointer' which advances
@@ -598,6 +598,13 @@ struct trx_sys_t {
 
 	trx_ids_t	rw_trx_ids;	/*!< Read write transaction IDs */
 
+	volatile ulint	rw_trx_ids_version;
+					/*!< Incremented every time
+					rw_trx_ids is modified. Written while
+					holding mutex, read without it by
+					AC-NL-RO transactions to check whether
+					their previous view can be reused */
+
 	char		pad3[64];	/*!< To avoid false sharing */
 	trx_rseg_t*	rseg_array[TRX_SYS_N_RSEGS];
 					/*!< Pointer array to rollback
@@ -41,6 +41,7 @@ Created 5/7/1996 Heikki Tuuri
 #include "trx0purge.h"
 #include "trx0sys.h"
 #include "srv0mon.h"
+#include "sync0sync.h"
 #include "ut0vec.h"
 #include "btr0btr.h"
 #include "dict0boot.h"
@@ -228,7 +229,7 @@ private:
 		ulint		m_heap_no;	/*!< heap number if rec lock */
 	};
 
-	/** Used in deadlock tracking. Protected by lock_sys->mutex. */
+	/** Used in deadlock tracking. Protected by lock_sys->latch. */
 	static ib_uint64_t	s_lock_mark_counter;
 
 	/** Calculation steps thus far. It is the count of the nodes visited. */
@@ -437,7 +438,12 @@ lock_sys_create(
 
 	lock_sys->last_slot = lock_sys->waiting_threads;
 
-	mutex_create(LATCH_ID_LOCK_SYS, &lock_sys->mutex);
+	rw_lock_create(lock_sys_latch_key, &lock_sys->latch, SYNC_LOCK_SYS);
+
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; ++i) {
+		mutex_create(LATCH_ID_LOCK_SYS_SHARD,
+			     &lock_sys->rec_shards[i].mutex);
+	}
 
 	mutex_create(LATCH_ID_LOCK_SYS_WAIT, &lock_sys->wait_mutex);
 
@@ -538,7 +544,12 @@ lock_sys_close(void)
 
 	os_event_destroy(lock_sys->timeout_event);
 
-	mutex_destroy(&lock_sys->mutex);
+	rw_lock_free(&lock_sys->latch);
+
+	for (ulint i = 0; i < LOCK_REC_N_SHARDS; ++i) {
+		mutex_destroy(&lock_sys->rec_shards[i].mutex);
+	}
+
 	mutex_destroy(&lock_sys->wait_mutex);
 
 	srv_slot_t*	slot = lock_sys->waiting_threads;
@@ -590,7 +601,7 @@ lock_get_src_table(
 	Other transactions could want to convert one of our implicit
 	record locks to an explicit one. For that, they would need our
 	trx mutex. Waiting locks can be removed while only holding
-	lock_sys->mutex, but this is a running transaction and cannot
+	lock_sys->latch, but this is a running transaction and cannot
 	thus be holding any waiting locks. */
 	trx_mutex_enter(trx);
 
@@ -1082,6 +1093,37 @@ lock_rec_get_prev(
 
 /*============= FUNCTIONS FOR ANALYZING RECORD LOCK QUEUE ================*/
 
+/** Checks if a record lock is a GRANTED explicit lock of a transaction that
+is stronger or equal to precise_mode.
+@param[in]	lock		record lock on the record
+@param[in]	precise_mode	LOCK_S or LOCK_X possibly ORed to LOCK_GAP
+				or LOCK_REC_NOT_GAP, for a supremum record
+				we regard this always a gap type request
+@param[in]	heap_no		heap number of the record
+@param[in]	trx		transaction
+@return true if the lock covers the request */
+UNIV_INLINE
+bool
+lock_rec_is_expl(
+	const lock_t*	lock,
+	ulint		precise_mode,
+	ulint		heap_no,
+	const trx_t*	trx)
+{
+	return(lock->trx == trx
+	       && !lock_rec_get_insert_intention(lock)
+	       && lock_mode_stronger_or_eq(
+		       lock_get_mode(lock),
+		       static_cast<lock_mode>(precise_mode & LOCK_MODE_MASK))
+	       && !lock_get_wait(lock)
+	       && (!lock_rec_get_rec_not_gap(lock)
+		   || (precise_mode & LOCK_REC_NOT_GAP)
+		   || heap_no == PAGE_HEAP_NO_SUPREMUM)
+	       && (!lock_rec_get_gap(lock)
+		   || (precise_mode & LOCK_GAP)
+		   || heap_no == PAGE_HEAP_NO_SUPREMUM));
+}
+
 /*********************************************************************//**
 Checks if a transaction has a GRANTED explicit lock on rec stronger or equal
 to precise_mode.
@@ -1111,19 +1153,7 @@ lock_rec_has_expl(
 	     lock != NULL;
 	     lock = lock_rec_get_next(heap_no, lock)) {
 
-		if (lock->trx == trx
-		    && !lock_rec_get_insert_intention(lock)
-		    && lock_mode_stronger_or_eq(
-			    lock_get_mode(lock),
-			    static_cast<lock_mode>(
-				    precise_mode & LOCK_MODE_MASK))
-		    && !lock_get_wait(lock)
-		    && (!lock_rec_get_rec_not_gap(lock)
-			|| (precise_mode & LOCK_REC_NOT_GAP)
-			|| heap_no == PAGE_HEAP_NO_SUPREMUM)
-		    && (!lock_rec_get_gap(lock)
-			|| (precise_mode & LOCK_GAP)
-			|| heap_no == PAGE_HEAP_NO_SUPREMUM)) {
+		if (lock_rec_is_expl(lock, precise_mode, heap_no, trx)) {
 
 			return(lock);
 		}
@@ -1213,6 +1243,55 @@ lock_rec_other_has_conflicting(
 	return(NULL);
 }
 
+/** Scans the lock queue of a record once to find out both whether the
+transaction already has a strong enough lock on the record (as
+lock_rec_has_expl()) and, if not, the first lock of another transaction
+that the request would have to wait for (as lock_rec_other_has_conflicting()).
+Doing both in one pass halves the time spent walking long queues of hot
+records while holding lock_sys->latch.
+@param[in]	mode		LOCK_S or LOCK_X possibly ORed to LOCK_GAP
+				or LOCK_REC_NOT_GAP
+@param[in]	block		buffer block containing the record
+@param[in]	heap_no		heap number of the record
+@param[in]	trx		our transaction
+@param[out]	wait_for	first conflicting lock, or NULL; only set
+				if false is returned
+@return true if trx already has a strong enough lock on the record */
+static
+bool
+lock_rec_queue_scan(
+	ulint			mode,
+	const buf_block_t*	block,
+	ulint			heap_no,
+	const trx_t*		trx,
+	const lock_t**		wait_for)
+{
+	ut_ad(lock_mutex_own());
+	ut_ad(!(mode & LOCK_INSERT_INTENTION));
+
+	bool	is_supremum = (heap_no == PAGE_HEAP_NO_SUPREMUM);
+
+	*wait_for = NULL;
+
+	for (const lock_t* lock = lock_rec_get_first(
+		     lock_sys->rec_hash, block, heap_no);
+	     lock != NULL;
+	     lock = lock_rec_get_next_const(heap_no, lock)) {
+
+		if (lock_rec_is_expl(lock, mode, heap_no, trx)) {
+			return(true);
+		}
+
+		if (*wait_for == NULL
+		    && lock_rec_has_to_wait(trx, mode, lock, is_supremum)) {
+
+			*wait_for = lock;
+		}
+	}
+
+	return(false);
+}
+
 /*********************************************************************//**
 Checks if some transaction has an implicit x-lock on a record in a secondary
 index.
@@ -1320,7 +1399,7 @@ lock_rec_other_trx_holds_expl(
 Return approximate number or record locks (bits set in the bitmap) for
 this transaction. Since delete-marked records may be removed, the
 record count will not be precise.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 ulint
 lock_number_of_rows_locked(
 /*=======================*/
@@ -1333,7 +1412,7 @@ lock_number_of_rows_locked(
 
 /*********************************************************************//**
 Return the number of table locks for a transaction.
-The caller must be holding lock_sys->mutex. */
+The caller must be holding lock_sys->latch. */
 ulint
 lock_number_of_tables_locked(
 /*=========================*/
@@ -1425,7 +1504,7 @@ RecLock::lock_alloc(
 	const RecID&	rec_id,
 	ulint		size)
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(rec_id.m_space_id, rec_id.m_page_no));
 
 	lock_t*	lock;
 
@@ -1475,9 +1554,11 @@ RecLock::lock_alloc(
 
 	lock_rec_set_nth_bit(lock, rec_id.m_heap_no);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK);
+	/* Locks of different record lock shards can be created at the
+	same time. */
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK);
 
-	MONITOR_INC(MONITOR_RECLOCK_CREATED);
+	MONITOR_ATOMIC_INC(MONITOR_RECLOCK_CREATED);
 
 	return(lock);
 }
@@ -1489,13 +1570,14 @@ Add the lock to the record lock hash and the transaction's lock list
 void
 RecLock::lock_add(lock_t* lock, bool add_to_hash)
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(m_rec_id.m_space_id, m_rec_id.m_page_no));
 	ut_ad(trx_mutex_own(lock->trx));
 
 	if (add_to_hash) {
 		ulint	key = m_rec_id.fold();
 
-		++lock->index->table->n_rec_locks;
+		os_atomic_increment_ulint(
+			&lock->index->table->n_rec_locks, 1);
 
 		HASH_INSERT(lock_t, hash, lock_hash_get(m_mode), key, lock);
 	}
@@ -1516,7 +1598,7 @@ Create a new lock.
 lock_t*
 RecLock::create(trx_t* trx, bool owns_trx_mutex, const lock_prdt_t* prdt)
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(m_rec_id.m_space_id, m_rec_id.m_page_no));
 	ut_ad(owns_trx_mutex == trx_mutex_own(trx));
 
 	/* Create the explicit lock instance and initialise it. */
@@ -1603,9 +1685,13 @@ RecLock::deadlock_check(lock_t* lock)
 
 	trx_mutex_exit(m_trx);
 
-	const trx_t*	victim_trx;
+	const trx_t*	victim_trx = NULL;
 
-	victim_trx = DeadlockChecker::check_and_resolve(lock, m_trx);
+	/* With asynchronous detection, the lock wait timeout thread
+	will look for the deadlock after we have been suspended. */
+	if (!srv_deadlock_detect_async) {
+		victim_trx = DeadlockChecker::check_and_resolve(lock, m_trx);
+	}
 
 	trx_mutex_enter(m_trx);
 
@@ -2129,7 +2215,8 @@ there are no explicit locks on the page, or there is just one lock, owned
 by this transaction, and of the right type_mode. This is a low-level function
 which does NOT look at implicit locks! Checks lock compatibility within
 explicit locks. This function sets a normal next-key lock, or in the case of
-a page supremum record, a gap type lock.
+a page supremum record, a gap type lock. The caller must hold either
+lock_sys->latch in exclusive mode or the record lock shard of the page.
 @return whether the locking succeeded */
 UNIV_INLINE
 lock_rec_req_status
@@ -2148,7 +2235,8 @@ lock_rec_lock_fast(
 	dict_index_t*		index,	/*!< in: index of record */
 	que_thr_t*		thr)	/*!< in: query thread */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(lock_rec_page_own(block->page.id.space(),
+				 block->page.id.page_no()));
 	ut_ad(!srv_read_only_mode);
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
@@ -2244,12 +2332,13 @@ lock_rec_lock_slow(
 
 	DBUG_EXECUTE_IF("innodb_report_deadlock", return(DB_DEADLOCK););
 
-	dberr_t	err;
-	trx_t*	trx = thr_get_trx(thr);
+	dberr_t		err;
+	trx_t*		trx = thr_get_trx(thr);
+	const lock_t*	wait_for;
 
 	trx_mutex_enter(trx);
 
-	if (lock_rec_has_expl(mode, block, heap_no, trx)) {
+	if (lock_rec_queue_scan(mode, block, heap_no, trx, &wait_for)) {
 
 		/* The trx already has a strong enough lock on rec: do
 		nothing */
@@ -2258,9 +2347,6 @@ lock_rec_lock_slow(
 
 	} else {
 
-		const lock_t* wait_for = lock_rec_other_has_conflicting(
-			mode, block, heap_no, trx);
-
 		if (wait_for != NULL) {
 
 			/* If another transaction has a non-gap conflicting
@@ -2297,7 +2383,9 @@ Tries to lock the specified record in the mode requested. If not immediately
 possible, enqueues a waiting lock request. This is a low-level function
 which does NOT look at implicit locks! Checks lock compatibility within
 explicit locks. This function sets a normal next-key lock, or in the case
-of a page supremum record, a gap type lock.
+of a page supremum record, a gap type lock. The common cases are handled
+under the record lock shard of the page; only the rest acquires
+lock_sys->latch in exclusive mode.
 @return DB_SUCCESS, DB_SUCCESS_LOCKED_REC, DB_LOCK_WAIT, DB_DEADLOCK,
 or DB_QUE_THR_SUSPENDED */
 static
@@ -2317,7 +2405,7 @@ lock_rec_lock(
 	dict_index_t*		index,	/*!< in: index of record */
 	que_thr_t*		thr)	/*!< in: query thread */
 {
-	ut_ad(lock_mutex_own());
+	ut_ad(!lock_mutex_own());
 	ut_ad(!srv_read_only_mode);
 	ut_ad((LOCK_MODE_MASK & mode) != LOCK_S
 	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
@@ -2330,20 +2418,39 @@ lock_rec_lock(
 	      || mode - (LOCK_MODE_MASK & mode) == 0);
 	ut_ad(dict_index_is_clust(index) || !dict_index_is_online_ddl(index));
 
+	MONITOR_ATOMIC_INC(MONITOR_NUM_RECLOCK_REQ);
+
+	ulint	space = block->page.id.space();
+	ulint	page_no = block->page.id.page_no();
+
 	/* We try a simplified and faster subroutine for the most
 	common cases */
-	switch (lock_rec_lock_fast(impl, mode, block, heap_no, index, thr)) {
+	lock_rec_shard_enter(space, page_no);
+
+	lock_rec_req_status	status = lock_rec_lock_fast(
+		impl, mode, block, heap_no, index, thr);
+
+	lock_rec_shard_exit(space, page_no);
+
+	switch (status) {
 	case LOCK_REC_SUCCESS:
 		return(DB_SUCCESS);
 	case LOCK_REC_SUCCESS_CREATED:
 		return(DB_SUCCESS_LOCKED_REC);
 	case LOCK_REC_FAIL:
-		return(lock_rec_lock_slow(impl, mode, block,
-					  heap_no, index, thr));
+		break;
 	}
 
-	ut_error;
-	return(DB_ERROR);
+	/* The queue may have changed after we released the shard, but
+	lock_rec_lock_slow() does not depend on what the fast path saw. */
+	lock_mutex_enter();
+
+	dberr_t	err = lock_rec_lock_slow(
+		impl, mode, block, heap_no, index, thr);
+
+	lock_mutex_exit();
+
+	return(err);
 }
 
 /*********************************************************************//**
@@ -2395,7 +2502,7 @@ lock_rec_has_to_wait_in_queue(
 
 /*************************************************************//**
 Grants a lock to a waiting lock request and releases the waiting transaction.
-The caller must hold lock_sys->mutex but not lock->trx->mutex. */
+The caller must hold lock_sys->latch but not lock->trx->mutex. */
 static
 void
 lock_grant(
@@ -3948,9 +4055,11 @@ lock_table_enqueue_waiting(
 
 	trx_mutex_exit(trx);
 
-	const trx_t*	victim_trx;
+	const trx_t*	victim_trx = NULL;
 
-	victim_trx = DeadlockChecker::check_and_resolve(lock, trx);
+	if (!srv_deadlock_detect_async) {
+		victim_trx = DeadlockChecker::check_and_resolve(lock, trx);
+	}
 
 	trx_mutex_enter(trx);
 
@@ -4508,7 +4617,7 @@ lock_remove_recovered_trx_record_locks(
 			continue;
 		}
 
-		/* Because we are holding the lock_sys->mutex,
+		/* Because we are holding the lock_sys->latch,
 		implicit locks cannot be converted to explicit ones
 		while we are scanning the explicit locks. */
 
@@ -5327,7 +5436,7 @@ lock_table_queue_validate(
 		/* lock->trx->state cannot change from or to NOT_STARTED
 		while we are holding the trx_sys->mutex. It may change
 		from ACTIVE to PREPARED, but it may not change to
-		COMMITTED, because we are holding the lock_sys->mutex. */
+		COMMITTED, because we are holding the lock_sys->latch. */
 		ut_ad(trx_assert_started(lock->trx));
 
 		if (!lock_get_wait(lock)) {
@@ -5417,7 +5526,7 @@ lock_rec_queue_validate(
 
 		ut_ad(lock_mutex_own());
 		/* impl_trx cannot be committed until lock_mutex_exit()
-		because lock_trx_release_locks() acquires lock_sys->mutex */
+		because lock_trx_release_locks() acquires lock_sys->latch */
 
 		if (impl_trx != NULL) {
 			const lock_t*	other_lock
@@ -6020,17 +6129,9 @@ lock_clust_rec_modify_check_and_lock(
 
 	lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 
-	lock_mutex_enter();
-
-	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	if (err == DB_SUCCESS_LOCKED_REC) {
@@ -6081,17 +6182,9 @@ lock_sec_rec_modify_check_and_lock(
 	index record, and this would not have been possible if another active
 	transaction had modified this secondary index record. */
 
-	lock_mutex_enter();
-
-	ut_ad(lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-
 	err = lock_rec_lock(TRUE, LOCK_X | LOCK_REC_NOT_GAP,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 #ifdef UNIV_DEBUG
 	{
 		mem_heap_t*	heap		= NULL;
@@ -6181,20 +6274,9 @@ lock_sec_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
-	ut_ad(mode != LOCK_X
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-	ut_ad(mode != LOCK_S
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
-
 	err = lock_rec_lock(FALSE, mode | gap_mode,
 			    block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	return(err);
@@ -6254,19 +6336,8 @@ lock_clust_rec_read_check_and_lock(
 		lock_rec_convert_impl_to_expl(block, rec, index, offsets);
 	}
 
-	lock_mutex_enter();
-
-	ut_ad(mode != LOCK_X
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IX));
-	ut_ad(mode != LOCK_S
-	      || lock_table_has(thr_get_trx(thr), index->table, LOCK_IS));
-
 	err = lock_rec_lock(FALSE, mode | gap_mode, block, heap_no, index, thr);
 
-	MONITOR_INC(MONITOR_NUM_RECLOCK_REQ);
-
-	lock_mutex_exit();
-
 	ut_ad(lock_rec_queue_validate(FALSE, block, rec, index, offsets));
 
 	DEBUG_SYNC_C("after_lock_clust_rec_read_check_and_lock");
@@ -6696,7 +6767,7 @@ lock_trx_release_locks(
 	}
 
 	/* The transition of trx->state to TRX_STATE_COMMITTED_IN_MEMORY
-	is protected by both the lock_sys->mutex and the trx->mutex. */
+	is protected by both the lock_sys->latch and the trx->mutex. */
 	lock_mutex_enter();
 
 	trx_mutex_enter(trx);
@@ -7504,6 +7575,81 @@ DeadlockChecker::check_and_resolve(const lock_t* lock, const trx_t* trx)
 	return(victim_trx);
 }
 
+/** Checks whether a transaction that is waiting for a lock is involved in
+a deadlock, and resolves it. This is how deadlocks are found when
+innodb_deadlock_detect_async is set: lock waits are enqueued without a
+deadlock check and the lock wait timeout thread calls this for every
+suspended transaction. The lock wait of the victim is cancelled, and the
+victim will return DB_DEADLOCK.
+@param[in,out]	trx	transaction waiting for a lock */
+void
+lock_wait_check_deadlock(
+	trx_t*	trx)
+{
+	ut_ad(lock_mutex_own());
+	ut_ad(!srv_read_only_mode);
+
+	/* The wait lock can only be granted or cancelled by a thread
+	that holds lock_sys->latch, so it stays valid while we search. */
+
+	trx_mutex_enter(trx);
+
+	const lock_t*	wait_lock = trx->lock.que_state == TRX_QUE_LOCK_WAIT
+		? trx->lock.wait_lock : NULL;
+
+	trx_mutex_exit(trx);
+
+	if (wait_lock == NULL) {
+		return;
+	}
+
+	trx_t*	victim_trx = const_cast<trx_t*>(
+		DeadlockChecker::check_and_resolve(wait_lock, trx));
+
+	if (victim_trx == NULL) {
+		/* No deadlock, or another transaction was rolled back. */
+		return;
+	}
+
+	if (victim_trx != trx) {
+		/* The search was too deep and trx_arbitrate() chose the
+		transaction holding the lock, because trx has the higher
+		priority. check_and_resolve() leaves that victim to the
+		caller. Cancel its lock wait. If it is not waiting, it is
+		running: it will release its locks, or wait for a lock
+		and be chosen again in a later round. Either way trx keeps
+		waiting, as trx_arbitrate() decided. */
+
+		ut_ad(trx_is_high_priority(trx));
+
+		trx_mutex_enter(victim_trx);
+
+		if (victim_trx->lock.que_state == TRX_QUE_LOCK_WAIT
+		    && victim_trx->lock.wait_lock != NULL) {
+
+			victim_trx->lock.was_chosen_as_deadlock_victim = true;
+
+			lock_cancel_waiting_and_release(
+				victim_trx->lock.wait_lock);
+		}
+
+		trx_mutex_exit(victim_trx);
+
+		return;
+	}
+
+	trx_mutex_enter(trx);
+
+	if (trx->lock.wait_lock != NULL) {
+
+		trx->lock.was_chosen_as_deadlock_victim = true;
+
+		lock_cancel_waiting_and_release(trx->lock.wait_lock);
+	}
+
+	trx_mutex_exit(trx);
+}
+
 /**
 Allocate cached locks for the transaction.
 @param trx		allocate cached record locks for this transaction */
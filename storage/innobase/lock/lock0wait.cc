@@ -507,6 +507,28 @@ DECLARE_THREAD(lock_wait_timeout_thread)(
 
 		lock_wait_mutex_enter();
 
+		if (srv_deadlock_detect_async) {
+
+			/* Lock waits were enqueued without a deadlock
+			check: look for deadlocks among all suspended
+			transactions before checking the timeouts, so
+			that a victim gets DB_DEADLOCK and not a timeout. */
+
+			lock_mutex_enter();
+
+			for (slot = lock_sys->waiting_threads;
+			     slot < lock_sys->last_slot;
+			     ++slot) {
+
+				if (slot->in_use) {
+					lock_wait_check_deadlock(
+						thr_get_trx(slot->thr));
+				}
+			}
+
+			lock_mutex_exit();
+		}
+
 		/* Check all slots for user threads that are waiting
 	       	on locks, and if they have exceeded the time limit. */
 
@@ -83,6 +83,15 @@ reduce the size of the log.
 /* Global log system variable */
 log_t*	log_sys	= NULL;
 
+/** Flag indicating if the log_flusher thread is active. It is set by
+the thread that creates log_flusher_thread, and cleared by that thread
+when it no longer accesses log_sys. */
+volatile bool	log_flusher_thread_active = false;
+
+#ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	log_flusher_thread_key;
+#endif /* UNIV_PFS_THREAD */
+
 /** Pointer to the log checksum calculation function */
 log_checksum_func_t log_checksum_algorithm_ptr =
 	log_block_calc_checksum_innodb;
@@ -154,6 +163,26 @@ log_buf_pool_get_oldest_modification(void)
 	return(lsn);
 }
 
+/** Wait until all the strings for which space was reserved by
+log_reserve_low() have been copied to the log buffer. The caller must
+hold the log mutex, so that no new space can be reserved meanwhile. */
+static
+void
+log_wait_for_copies(void)
+{
+	ut_ad(log_mutex_own());
+
+	for (ulint i = 0; log_sys->n_pending_copies > 0; i++) {
+		if (i < srv_n_spin_wait_rounds) {
+			ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+		} else {
+			os_thread_yield();
+		}
+	}
+
+	os_rmb;
+}
+
 /** Extends the log buffer.
 @param[in]	len	requested minimum size in bytes */
 void
@@ -206,6 +235,8 @@ log_buffer_extend(
 		log_mutex_enter();
 	}
 
+	log_wait_for_copies();
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -353,14 +384,17 @@ loop:
 	return(log_sys->lsn);
 }
 
-/************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
+/** Advance the log buffer and the lsn over a string, formatting the
+log block headers and trailers on the way. It is assumed that the caller
+holds the log mutex.
+@param[in]	str	string to catenate, or NULL if the string will
+be copied later by log_buffer_copy()
+@param[in]	str_len	string length */
+static
 void
-log_write_low(
-/*==========*/
-	const byte*	str,		/*!< in: string */
-	ulint		str_len)	/*!< in: string length */
+log_write_or_reserve_low(
+	const byte*	str,
+	ulint		str_len)
 {
 	log_t*	log	= log_sys;
 	ulint	len;
@@ -387,10 +421,12 @@ part_loop:
 			- LOG_BLOCK_TRL_SIZE;
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
+	if (str != NULL) {
+		ut_memcpy(log->buf + log->buf_free, str, len);
+		str = str + len;
+	}
 
 	str_len -= len;
-	str = str + len;
 
 	log_block = static_cast<byte*>(
 		ut_align_down(
@@ -424,6 +460,89 @@ part_loop:
 	srv_stats.log_write_requests.inc();
 }
 
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+void
+log_write_low(
+/*==========*/
+	const byte*	str,		/*!< in: string */
+	ulint		str_len)	/*!< in: string length */
+{
+	ut_ad(str != NULL);
+
+	log_write_or_reserve_low(str, str_len);
+}
+
+/** Reserve space in the log buffer for a string that will be copied
+there by log_buffer_copy() after the log mutex has been released. The
+log block headers and trailers of the reserved area are formatted here.
+Every call must be paired with a call to log_buffer_copy_end(). It is
+assumed that the caller holds the log mutex.
+@param[in]	str_len	string length
+@return start of the reserved area in the log buffer */
+byte*
+log_reserve_low(
+	ulint	str_len)
+{
+	byte*	buf = log_sys->buf + log_sys->buf_free;
+
+	ut_ad(str_len > 0);
+
+	log_write_or_reserve_low(NULL, str_len);
+
+	os_atomic_increment_ulint(&log_sys->n_pending_copies, 1);
+
+	return(buf);
+}
+
+/** Copy a string to an area of the log buffer that was reserved by
+log_reserve_low(), skipping the log block headers and trailers. This
+does not require the log mutex.
+@param[in,out]	buf	position in the reserved area
+@param[in]	str	string
+@param[in]	str_len	string length
+@return position in the reserved area after the string */
+byte*
+log_buffer_copy(
+	byte*		buf,
+	const byte*	str,
+	ulint		str_len)
+{
+	while (str_len > 0) {
+		ulint	avail = OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE
+			- ut_align_offset(buf, OS_FILE_LOG_BLOCK_SIZE);
+		ulint	len = ut_min(str_len, avail);
+
+		ut_ad(ut_align_offset(buf, OS_FILE_LOG_BLOCK_SIZE)
+		      >= LOG_BLOCK_HDR_SIZE);
+
+		::memcpy(buf, str, len);
+
+		buf += len;
+		str += len;
+		str_len -= len;
+
+		if (len == avail) {
+			/* Skip the trailer of this block and the
+			header of the next one. */
+			buf += LOG_BLOCK_TRL_SIZE + LOG_BLOCK_HDR_SIZE;
+		}
+	}
+
+	return(buf);
+}
+
+/** Note that a string has been copied to the area of the log buffer that
+was reserved by log_reserve_low(). */
+void
+log_buffer_copy_end(void)
+{
+	ut_ad(log_sys->n_pending_copies > 0);
+
+	os_atomic_decrement_ulint(&log_sys->n_pending_copies, 1);
+}
+
 /************************************************************//**
 Closes the log.
 @return lsn */
@@ -775,6 +894,12 @@ log_init(void)
 
 	os_event_set(log_sys->flush_event);
 
+	log_sys->flusher_event = os_event_create(0);
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		log_sys->wait_events[i] = os_event_create(0);
+	}
+
 	/*----------------------------*/
 
 	log_sys->last_checkpoint_lsn = log_sys->lsn;
@@ -866,6 +991,7 @@ log_sys_write_completion(void)
 	ulint	move_end;
 
 	ut_ad(log_mutex_own());
+	ut_ad(log_sys->n_pending_copies == 0);
 
 	log_sys->write_lsn = log_sys->lsn;
 	log_sys->buf_next_to_write = log_sys->write_end_offset;
@@ -1255,6 +1381,10 @@ loop:
 		}
 	}
 
+	/* Let the pending copies complete the log blocks that we are
+	about to write. */
+	log_wait_for_copies();
+
 	group = UT_LIST_GET_FIRST(log_sys->log_groups);
 
 	start_offset = log_sys->buf_next_to_write;
@@ -1373,6 +1503,181 @@ log_buffer_sync_in_background(
 	log_write_up_to(lsn, flush);
 }
 
+/** Get the event on which the threads waiting in log_wait_up_to() for an
+lsn sleep.
+@param[in]	lsn	log sequence number
+@return event for the log block of lsn */
+static
+os_event_t
+log_wait_event(
+	lsn_t	lsn)
+{
+	return(log_sys->wait_events[
+		(lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_N_WAIT_EVENTS]);
+}
+
+/** Wake up the threads in log_wait_up_to() that wait for an lsn in a range
+that has been written or flushed since the previous notification.
+@param[in]	old_lsn	lsn up to which the waiters were notified
+@param[in]	new_lsn	lsn up to which the log was written or flushed */
+static
+void
+log_wait_notify(
+	lsn_t	old_lsn,
+	lsn_t	new_lsn)
+{
+	if (new_lsn <= old_lsn) {
+		return;
+	}
+
+	lsn_t	first = old_lsn / OS_FILE_LOG_BLOCK_SIZE;
+	lsn_t	last = new_lsn / OS_FILE_LOG_BLOCK_SIZE;
+
+	if (last - first >= LOG_N_WAIT_EVENTS) {
+		first = 0;
+		last = LOG_N_WAIT_EVENTS - 1;
+	}
+
+	for (lsn_t block = first; block <= last; block++) {
+		os_event_set(log_sys->wait_events[
+			block % LOG_N_WAIT_EVENTS]);
+	}
+}
+
+/** Wait until the log has been written to the log file up to a given
+log entry (such as that of a transaction commit). The write, and the
+flush if requested, are done by the log_flusher thread, which covers all
+the waiting threads at once; if that thread is not running, this
+invokes log_write_up_to().
+@param[in]	lsn		log sequence number that should be
+included in the redo log file write
+@param[in]	flush_to_disk	whether the written log should also
+be flushed to the file system */
+void
+log_wait_up_to(
+	lsn_t	lsn,
+	bool	flush_to_disk)
+{
+	ut_ad(!srv_read_only_mode);
+
+#if UNIV_WORD_SIZE > 7
+	os_event_t	event = log_wait_event(lsn);
+
+	while (log_flusher_thread_active) {
+		/* Reset the event before checking the lsn, so that a
+		notification after the check will not be missed. */
+		int64_t	sig_count = os_event_reset(event);
+
+		/* We can do a dirty read of LSN. */
+		os_rmb;
+		lsn_t	limit_lsn = flush_to_disk
+			? log_sys->flushed_to_disk_lsn
+			: log_sys->write_lsn;
+
+		if (limit_lsn >= lsn) {
+			return;
+		}
+
+		if (flush_to_disk) {
+			log_sys->flusher_flush_requested = true;
+		}
+
+		os_event_set(log_sys->flusher_event);
+
+		MONITOR_INC(MONITOR_LOG_FLUSHER_WAITS);
+
+		/* The timeout covers the exit of the log_flusher thread
+		while we are waiting. */
+		os_event_wait_time_low(event, 100000, sig_count);
+	}
+#endif /* UNIV_WORD_SIZE > 7 */
+
+	log_write_up_to(lsn, flush_to_disk);
+}
+
+/******************************************************************//**
+The log_flusher thread writes and flushes the log on behalf of the
+threads waiting in log_wait_up_to().
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg __attribute__((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ut_ad(!srv_read_only_mode);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(log_flusher_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+#ifdef UNIV_DEBUG_THREAD_CREATION
+	ib::info() << "log_flusher thread running, id "
+		<< os_thread_pf(os_thread_get_curr_id());
+#endif /* UNIV_DEBUG_THREAD_CREATION */
+
+	log_mutex_enter();
+	lsn_t	notified_write_lsn = log_sys->write_lsn;
+	lsn_t	notified_flush_lsn = log_sys->flushed_to_disk_lsn;
+	log_mutex_exit();
+
+	while (srv_shutdown_state < SRV_SHUTDOWN_FLUSH_PHASE) {
+
+		os_event_wait_time(log_sys->flusher_event, 1000000);
+
+		/* Reset the event before reading the request, so that
+		a request made after the reset wakes us up again. */
+		os_event_reset(log_sys->flusher_event);
+
+		bool	flush = log_sys->flusher_flush_requested;
+
+		if (flush) {
+			log_sys->flusher_flush_requested = false;
+		}
+
+		/* Write everything that has been generated so far: this
+		covers the lsn of all the waiters that woke us up. */
+		log_write_up_to(log_get_lsn(), flush);
+
+		if (flush) {
+			MONITOR_INC(MONITOR_LOG_FLUSHER_FLUSHES);
+		}
+
+		log_mutex_enter();
+		lsn_t	write_lsn = log_sys->write_lsn;
+		lsn_t	flush_lsn = log_sys->flushed_to_disk_lsn;
+		log_mutex_exit();
+
+		/* The log may also have been written or flushed by other
+		threads, for example by a checkpoint. Notify the waiters
+		of all the progress made since the previous round. */
+		log_wait_notify(notified_write_lsn, write_lsn);
+		log_wait_notify(notified_flush_lsn, flush_lsn);
+
+		notified_write_lsn = write_lsn;
+		notified_flush_lsn = flush_lsn;
+
+		DBUG_EXECUTE_IF("log_flusher_delay", os_thread_sleep(100000););
+	}
+
+	/* Let the remaining waiters write the log themselves. They
+	check the flag again after their timed wait. */
+	log_wait_notify(0, LSN_MAX);
+
+	/* log_sys may be freed as soon as the flag is cleared. */
+	os_wmb;
+	log_flusher_thread_active = false;
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
 /********************************************************************
 
 Tries to establish a big enough margin of free space in the log buffer, such
@@ -2169,6 +2474,17 @@ loop:
 	before proceeding further. */
 	srv_shutdown_state = SRV_SHUTDOWN_FLUSH_PHASE;
 	count = 0;
+
+	/* The log_flusher thread exits in the flush phase. */
+	for (;;) {
+		os_rmb;
+		if (!log_flusher_thread_active) {
+			break;
+		}
+		os_event_set(log_sys->flusher_event);
+		os_thread_sleep(10000);
+	}
+
 	while (buf_page_cleaner_is_active) {
 		++count;
 		os_thread_sleep(100000);
@@ -2469,6 +2785,12 @@ log_shutdown(void)
 
 	os_event_destroy(log_sys->flush_event);
 
+	os_event_destroy(log_sys->flusher_event);
+
+	for (ulint i = 0; i < LOG_N_WAIT_EVENTS; i++) {
+		os_event_destroy(log_sys->wait_events[i]);
+	}
+
 	rw_lock_free(&log_sys->checkpoint_lock);
 
 	mutex_free(&log_sys->mutex);
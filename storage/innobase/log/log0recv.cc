@@ -145,6 +145,7 @@ mysql_pfs_key_t	trx_rollback_clean_thread_key;
 
 #ifndef UNIV_HOTBACKUP
 # ifdef UNIV_PFS_THREAD
+mysql_pfs_key_t	recv_apply_thread_key;
 mysql_pfs_key_t	recv_writer_thread_key;
 # endif /* UNIV_PFS_THREAD */
 
@@ -2089,48 +2090,30 @@ recv_read_in_area(
 	return(n);
 }
 
-/*******************************************************************//**
-Empties the hash table of stored log records, applying them to appropriate
-pages. */
+/** Apply the hashed log records of the hash table cells that are assigned
+to one of the threads running an apply batch. The cells are distributed
+round-robin, so that the pages are spread evenly over the threads and no
+page is handled by two of them. Pages that are not in the buffer pool are
+read in together with their neighbours, and the log records are applied
+to them by the i/o handler threads. The caller must own recv_sys->mutex.
+@param[in]	thread_no	index of this thread in the batch
+@param[in]	n_threads	number of threads applying the batch
+@param[in]	print_progress	whether to report the progress */
+static
 void
-recv_apply_hashed_log_recs(
-/*=======================*/
-	ibool	allow_ibuf)	/*!< in: if TRUE, also ibuf operations are
-				allowed during the application; if FALSE,
-				no ibuf operations are allowed, and after
-				the application all file pages are flushed to
-				disk and invalidated in buffer pool: this
-				alternative means that no new log records
-				can be generated during the application;
-				the caller must in this case own the log
-				mutex */
+recv_apply_hashed_log_recs_low(
+	ulint	thread_no,
+	ulint	n_threads,
+	bool	print_progress)
 {
-	recv_addr_t* recv_addr;
-	ulint	i;
-	ibool	has_printed	= FALSE;
-	mtr_t	mtr;
-loop:
-	mutex_enter(&(recv_sys->mutex));
-
-	if (recv_sys->apply_batch_on) {
-
-		mutex_exit(&(recv_sys->mutex));
-
-		os_thread_sleep(500000);
-
-		goto loop;
-	}
-
-	ut_ad(!allow_ibuf == log_mutex_own());
-
-	if (!allow_ibuf) {
-		recv_no_ibuf_operations = true;
-	}
+	recv_addr_t*	recv_addr;
+	const ulint	n_cells = hash_get_n_cells(recv_sys->addr_hash);
+	mtr_t		mtr;
 
-	recv_sys->apply_log_recs = TRUE;
-	recv_sys->apply_batch_on = TRUE;
+	ut_ad(mutex_own(&recv_sys->mutex));
+	ut_ad(thread_no < n_threads);
 
-	for (i = 0; i < hash_get_n_cells(recv_sys->addr_hash); i++) {
+	for (ulint i = thread_no; i < n_cells; i += n_threads) {
 
 		for (recv_addr = static_cast<recv_addr_t*>(
 				HASH_GET_FIRST(recv_sys->addr_hash, i));
@@ -2163,15 +2146,6 @@ loop:
 			ut_ad(found);
 
 			if (recv_addr->state == RECV_NOT_PROCESSED) {
-				if (!has_printed) {
-					ib::info() << "Starting an apply batch"
-						" of log records"
-						" to the database...";
-					fputs("InnoDB: Progress in percent: ",
-					      stderr);
-					has_printed = TRUE;
-				}
-
 				mutex_exit(&(recv_sys->mutex));
 
 				if (buf_page_peek(page_id)) {
@@ -2196,20 +2170,117 @@ loop:
 			}
 		}
 
-		if (has_printed
-		    && (i * 100) / hash_get_n_cells(recv_sys->addr_hash)
-		    != ((i + 1) * 100)
-		    / hash_get_n_cells(recv_sys->addr_hash)) {
+		if (print_progress
+		    && (i * 100) / n_cells
+		    != ((i + n_threads) * 100) / n_cells) {
 
-			fprintf(stderr, "%lu ", (ulong)
-				((i * 100)
-				 / hash_get_n_cells(recv_sys->addr_hash)));
+			fprintf(stderr, "%lu ", (ulong) ((i * 100) / n_cells));
 		}
 	}
+}
+
+/******************************************************************//**
+Thread that applies the hashed log records of its share of the hash table
+cells during an apply batch.
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(recv_apply_thread)(
+/*==============================*/
+	void*	arg)	/*!< in: index of the thread in the batch */
+{
+	const ulint	thread_no = reinterpret_cast<ulint>(arg);
+
+#ifdef UNIV_PFS_THREAD
+	pfs_register_thread(recv_apply_thread_key);
+#endif /* UNIV_PFS_THREAD */
+
+	mutex_enter(&(recv_sys->mutex));
+
+	recv_apply_hashed_log_recs_low(
+		thread_no, srv_n_recv_apply_threads, false);
+
+	ut_a(recv_sys->n_apply_threads);
+	recv_sys->n_apply_threads--;
+
+	mutex_exit(&(recv_sys->mutex));
+
+	/* We count the number of threads in os_thread_exit().
+	A created thread should always use that to exit and not
+	use return() to exit. */
+	os_thread_exit(NULL);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*******************************************************************//**
+Empties the hash table of stored log records, applying them to appropriate
+pages. */
+void
+recv_apply_hashed_log_recs(
+/*=======================*/
+	ibool	allow_ibuf)	/*!< in: if TRUE, also ibuf operations are
+				allowed during the application; if FALSE,
+				no ibuf operations are allowed, and after
+				the application all file pages are flushed to
+				disk and invalidated in buffer pool: this
+				alternative means that no new log records
+				can be generated during the application;
+				the caller must in this case own the log
+				mutex */
+{
+	ibool		has_printed	= FALSE;
+	const ulint	n_threads	= srv_n_recv_apply_threads;
+	ulint		n_pages;
+	ib_time_t	start_time;
+loop:
+	mutex_enter(&(recv_sys->mutex));
+
+	if (recv_sys->apply_batch_on) {
+
+		mutex_exit(&(recv_sys->mutex));
+
+		os_thread_sleep(500000);
+
+		goto loop;
+	}
+
+	ut_ad(!allow_ibuf == log_mutex_own());
+
+	if (!allow_ibuf) {
+		recv_no_ibuf_operations = true;
+	}
+
+	recv_sys->apply_log_recs = TRUE;
+	recv_sys->apply_batch_on = TRUE;
+
+	n_pages = recv_sys->n_addrs;
+	start_time = ut_time();
+
+	if (n_pages > 0) {
+		ib::info() << "Starting an apply batch of log records"
+			" to the database for " << n_pages << " pages"
+			" using " << n_threads << " threads...";
+		fputs("InnoDB: Progress in percent: ", stderr);
+		has_printed = TRUE;
+	}
+
+	ut_a(n_threads > 0);
+	ut_ad(recv_sys->n_apply_threads == 0);
+
+	/* This thread applies the share of the first thread, and
+	the other shares are applied by recv_apply_thread instances. */
+	for (ulint i = 1; i < n_threads; i++) {
+		recv_sys->n_apply_threads++;
+		os_thread_create(recv_apply_thread,
+				 reinterpret_cast<void*>(i), NULL);
+	}
+
+	recv_apply_hashed_log_recs_low(0, n_threads, has_printed);
 
 	/* Wait until all the pages have been processed */
 
-	while (recv_sys->n_addrs != 0) {
+	while (recv_sys->n_addrs != 0 || recv_sys->n_apply_threads != 0) {
 
 		mutex_exit(&(recv_sys->mutex));
 
@@ -2262,7 +2333,9 @@ loop:
 	recv_sys_empty_hash();
 
 	if (has_printed) {
-		ib::info() << "Apply batch completed";
+		ib::info() << "Apply batch completed: " << n_pages
+			<< " pages in " << ut_time() - start_time
+			<< " seconds";
 	}
 
 	mutex_exit(&(recv_sys->mutex));
@@ -330,7 +330,8 @@ public:
 	@param[in,out]	mtr	mini-transaction */
 	explicit Command(mtr_t* mtr)
 		:
-		m_locks_released()
+		m_locks_released(),
+		m_log_buf()
 	{
 		init(mtr);
 	}
@@ -372,6 +373,16 @@ private:
 	@return number of bytes to write in finish_write() */
 	ulint prepare_write();
 
+	/** Reserve space for the redo log records in the redo log buffer.
+	Short records are appended right away; longer ones are appended by
+	copy_log(), which may be invoked after releasing log_sys->mutex.
+	@param[in]	len	number of bytes to write */
+	void reserve_write(ulint len);
+
+	/** Copy the redo log records to the space that was reserved
+	for them by reserve_write(), if they were not appended yet. */
+	void copy_log();
+
 	/** true if it is a sync mini-transaction. */
 	bool			m_sync;
 
@@ -387,6 +398,10 @@ private:
 
 	/** End lsn of the possible log entry for this mtr */
 	lsn_t			m_end_lsn;
+
+	/** Space reserved in the redo log buffer for the log entry
+	of this mtr, or NULL if there is nothing to copy there */
+	byte*			m_log_buf;
 };
 
 /** Check if a mini-transaction is dirtying a clean page.
@@ -414,6 +429,24 @@ struct mtr_write_log_t {
 	}
 };
 
+/** Copy the block contents to space reserved in the REDO log buffer */
+struct mtr_copy_log_t {
+	/** Constructor
+	@param[in]	buf	start of the reserved space */
+	explicit mtr_copy_log_t(byte* buf) : m_buf(buf) {}
+
+	/** Copy a block to the reserved space.
+	@return whether the copying should continue */
+	bool operator()(const mtr_buf_t::block_t* block)
+	{
+		m_buf = log_buffer_copy(m_buf, block->begin(), block->used());
+		return(true);
+	}
+
+	/** Current position in the reserved space */
+	byte*	m_buf;
+};
+
 /** Append records to the system-wide redo log buffer.
 @param[in]	log	redo log records */
 void
@@ -784,16 +817,17 @@ mtr_t::Command::prepare_write()
 	return(len);
 }
 
-/** Append the redo log records to the redo log buffer
+/** Reserve space for the redo log records in the redo log buffer.
 @param[in] len	number of bytes to write */
 void
-mtr_t::Command::finish_write(
+mtr_t::Command::reserve_write(
 	ulint	len)
 {
 	ut_ad(m_impl->m_log_mode == MTR_LOG_ALL);
 	ut_ad(log_mutex_own());
 	ut_ad(m_impl->m_log.size() == len);
 	ut_ad(len > 0);
+	ut_ad(m_log_buf == NULL);
 
 	if (m_impl->m_log.is_small()) {
 		const mtr_buf_t::block_t*	front = m_impl->m_log.front();
@@ -807,15 +841,41 @@ mtr_t::Command::finish_write(
 		}
 	}
 
-	/* Open the database log for log_write_low */
+	/* Open the database log and reserve space for the records
+	to be copied by copy_log() */
 	m_start_lsn = log_reserve_and_open(len);
 
-	mtr_write_log_t	write_log;
-	m_impl->m_log.for_each_block(write_log);
+	m_log_buf = log_reserve_low(len);
 
 	m_end_lsn = log_close();
 }
 
+/** Copy the redo log records to the space reserved by reserve_write(). */
+void
+mtr_t::Command::copy_log()
+{
+	if (m_log_buf == NULL) {
+		return;
+	}
+
+	mtr_copy_log_t	copy_log(m_log_buf);
+	m_impl->m_log.for_each_block(copy_log);
+
+	log_buffer_copy_end();
+
+	m_log_buf = NULL;
+}
+
+/** Append the redo log records to the redo log buffer
+@param[in] len	number of bytes to write */
+void
+mtr_t::Command::finish_write(
+	ulint	len)
+{
+	reserve_write(len);
+	copy_log();
+}
+
 /** Release the latches and blocks acquired by this mini-transaction */
 void
 mtr_t::Command::release_all()
@@ -860,7 +920,7 @@ mtr_t::Command::execute()
 	ut_ad(m_impl->m_log_mode != MTR_LOG_NONE);
 
 	if (const ulint len = prepare_write()) {
-		finish_write(len);
+		reserve_write(len);
 	}
 
 	if (m_impl->m_made_dirty) {
@@ -872,6 +932,12 @@ mtr_t::Command::execute()
 	to insert into the flush list. */
 	log_mutex_exit();
 
+	/* The space for our log records has been reserved, and the
+	log buffer will not be written past it before copy_log() is
+	done. Copy without holding the log mutex, so that other
+	mini-transactions can reserve space meanwhile. */
+	copy_log();
+
 	m_impl->m_mtr->m_commit_lsn = m_end_lsn;
 
 	release_blocks();
@@ -69,7 +69,10 @@ Created 10/21/1995 Heikki Tuuri
 # include <linux/falloc.h>
 #endif /* HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE */
 
+#include "srv0mon.h"
+
 #include <lz4.h>
+#include <lz4hc.h>
 #include <zlib.h>
 
 #ifdef UNIV_DEBUG
@@ -1219,53 +1222,34 @@ os_file_compress_page(
 
 	/* Only compress the data + trailer, leave the header alone */
 
-	switch (compression.m_type) {
-	case Compression::NONE:
-		ut_error;
-
-	case Compression::ZLIB: {
+	const ulint	type = compression.m_type - Compression::ZLIB;
+	const bool	monitor = MONITOR_IS_ON(
+		MONITOR_PAGE_CODEC_COMPRESSED_ZLIB + type);
+	uintmax_t	start_time = monitor ? ut_time_us(NULL) : 0;
 
-		uLongf	zlen = static_cast<uLongf>(out_len);
+	len = Compression::compress(
+		compression.m_type, compression_level,
+		src + FIL_PAGE_DATA, content_len,
+		dst + FIL_PAGE_DATA, out_len);
 
-		if (compress2(
-			dst + FIL_PAGE_DATA,
-			&zlen,
-			src + FIL_PAGE_DATA,
-			static_cast<uLong>(content_len),
-			static_cast<int>(compression_level)) != Z_OK) {
+	if (len == 0 || len >= out_len) {
 
-			*dst_len = src_len;
-
-			return(src);
-		}
-
-		len = static_cast<ulint>(zlen);
+		*dst_len = src_len;
 
-		break;
+		return(src);
 	}
 
-	case Compression::LZ4:
-
-		len = LZ4_compress_limitedOutput(
-			reinterpret_cast<char*>(src) + FIL_PAGE_DATA,
-			reinterpret_cast<char*>(dst) + FIL_PAGE_DATA,
-			static_cast<int>(content_len),
-			static_cast<int>(out_len));
-
-		ut_a(len <= src_len - FIL_PAGE_DATA);
-
-		if (len == 0  || len >= out_len) {
-
-			*dst_len = src_len;
-
-			return(src);
-		}
-
-		break;
-
-	default:
-		*dst_len = src_len;
-		return(src);
+	if (monitor) {
+		MONITOR_INC_NOCHECK(
+			monitor_id_t(MONITOR_PAGE_CODEC_COMPRESSED_ZLIB
+				     + type));
+		MONITOR_INC_VALUE(
+			monitor_id_t(MONITOR_PAGE_CODEC_COMPRESS_TIME_ZLIB
+				     + type),
+			ut_time_us(NULL) - start_time);
+		MONITOR_INC_VALUE(
+			monitor_id_t(MONITOR_PAGE_CODEC_SAVED_ZLIB + type),
+			content_len - len);
 	}
 
 	ut_a(len <= out_len);
@@ -1282,7 +1266,8 @@ os_file_compress_page(
 
 	mach_write_to_1(dst + FIL_PAGE_VERSION, 1);
 
-	mach_write_to_1(dst + FIL_PAGE_ALGORITHM_V1, compression.m_type);
+	mach_write_to_1(dst + FIL_PAGE_ALGORITHM_V1,
+			Compression::stored_type(compression.m_type));
 
 	mach_write_to_2(dst + FIL_PAGE_ORIGINAL_TYPE_V1, page_type);
 
@@ -8028,30 +8013,243 @@ os_file_set_umask(ulint umask)
 #include "os0file.h"
 
 #include <lz4.h>
+#include <lz4hc.h>
 #include <zlib.h>
 
 #endif /* !UNIV_INNOCHECKSUM */
 
+/** Compress data with zlib, see Compression::compress() */
+static
+ulint
+page_codec_zlib_compress(
+	ulint		level,
+	const byte*	src,
+	ulint		src_len,
+	byte*		dst,
+	ulint		dst_len)
+{
+	uLongf	zlen = static_cast<uLongf>(dst_len);
+
+	if (compress2(dst, &zlen, src, static_cast<uLong>(src_len),
+		      static_cast<int>(level)) != Z_OK) {
+
+		return(0);
+	}
+
+	return(static_cast<ulint>(zlen));
+}
+
+/** Decompress zlib data, see Compression::decompress() */
+static
+bool
+page_codec_zlib_decompress(
+	bool		safe,
+	const byte*	src,
+	ulint		src_len,
+	byte*		dst,
+	ulint		dst_len)
+{
+	uLongf	zlen = static_cast<uLongf>(dst_len);
+
+	return(uncompress(dst, &zlen, src, static_cast<uLong>(src_len))
+	       == Z_OK
+	       && zlen == dst_len);
+}
+
+/** Compress data with LZ4, see Compression::compress() */
+static
+ulint
+page_codec_lz4_compress(
+	ulint		level,
+	const byte*	src,
+	ulint		src_len,
+	byte*		dst,
+	ulint		dst_len)
+{
+	int	len = LZ4_compress_limitedOutput(
+		reinterpret_cast<const char*>(src),
+		reinterpret_cast<char*>(dst),
+		static_cast<int>(src_len),
+		static_cast<int>(dst_len));
+
+	return(len > 0 ? static_cast<ulint>(len) : 0);
+}
+
+/** Compress data with the LZ4 high compression variant,
+see Compression::compress() */
+static
+ulint
+page_codec_lz4hc_compress(
+	ulint		level,
+	const byte*	src,
+	ulint		src_len,
+	byte*		dst,
+	ulint		dst_len)
+{
+	int	len = LZ4_compressHC2_limitedOutput(
+		reinterpret_cast<const char*>(src),
+		reinterpret_cast<char*>(dst),
+		static_cast<int>(src_len),
+		static_cast<int>(dst_len),
+		static_cast<int>(level));
+
+	return(len > 0 ? static_cast<ulint>(len) : 0);
+}
+
+/** Decompress LZ4 data, see Compression::decompress() */
+static
+bool
+page_codec_lz4_decompress(
+	bool		safe,
+	const byte*	src,
+	ulint		src_len,
+	byte*		dst,
+	ulint		dst_len)
+{
+	if (safe) {
+		return(LZ4_decompress_safe(
+			       reinterpret_cast<const char*>(src),
+			       reinterpret_cast<char*>(dst),
+			       static_cast<int>(src_len),
+			       static_cast<int>(dst_len))
+		       == static_cast<int>(dst_len));
+	}
+
+	/* This can potentially read beyond the input buffer if the
+	data is malformed. According to the LZ4 documentation it is a
+	little faster than the above function. */
+	return(LZ4_decompress_fast(
+		       reinterpret_cast<const char*>(src),
+		       reinterpret_cast<char*>(dst),
+		       static_cast<int>(dst_len))
+	       >= 0);
+}
+
+/** A page compression algorithm */
+struct page_codec_t {
+	/** Name of the algorithm */
+	const char*	name;
+
+	/** Algorithm written to the page header */
+	Compression::Type	stored_type;
+
+	/** Compress, see Compression::compress() */
+	ulint		(*compress)(
+		ulint		level,
+		const byte*	src,
+		ulint		src_len,
+		byte*		dst,
+		ulint		dst_len);
+
+	/** Decompress, see Compression::decompress() */
+	bool		(*decompress)(
+		bool		safe,
+		const byte*	src,
+		ulint		src_len,
+		byte*		dst,
+		ulint		dst_len);
+};
+
+/** The page compression algorithms, indexed by Compression::Type */
+static const page_codec_t	page_codecs[] = {
+	{"None", Compression::NONE, NULL, NULL},
+	{"Zlib", Compression::ZLIB,
+	 page_codec_zlib_compress, page_codec_zlib_decompress},
+	{"LZ4", Compression::LZ4,
+	 page_codec_lz4_compress, page_codec_lz4_decompress},
+	/* The output of LZ4HC is LZ4 data. Marking the pages as LZ4
+	keeps them readable by servers and tools that do not know
+	LZ4HC. */
+	{"LZ4HC", Compression::LZ4, page_codec_lz4hc_compress, NULL}
+};
+
+/** Compress data with an algorithm.
+@param[in]	type		compression algorithm, not NONE
+@param[in]	level		compression level, interpreted by
+				the algorithm (innodb_compression_level)
+@param[in]	src		data to compress
+@param[in]	src_len		length of src in bytes
+@param[out]	dst		compressed data
+@param[in]	dst_len		size of dst in bytes
+@return length of the compressed data, or 0 if it did not fit
+in dst_len bytes */
+ulint
+Compression::compress(
+	Type		type,
+	ulint		level,
+	const byte*	src,
+	ulint		src_len,
+	byte*		dst,
+	ulint		dst_len)
+{
+	ut_ad(type != NONE);
+
+	if (type >= UT_ARR_SIZE(page_codecs)
+	    || page_codecs[type].compress == NULL) {
+
+		return(0);
+	}
+
+	ulint	len = page_codecs[type].compress(
+		level, src, src_len, dst, dst_len);
+
+	ut_a(len <= dst_len);
+
+	return(len);
+}
+
+/** Decompress data that was compressed with compress().
+@param[in]	type		compression algorithm, not NONE
+@param[in]	safe		whether src may be malformed
+@param[in]	src		compressed data
+@param[in]	src_len		length of src in bytes
+@param[out]	dst		decompressed data
+@param[in]	dst_len		length of the decompressed data
+@return whether the data was decompressed */
+bool
+Compression::decompress(
+	Type		type,
+	bool		safe,
+	const byte*	src,
+	ulint		src_len,
+	byte*		dst,
+	ulint		dst_len)
+{
+	ut_ad(type != NONE);
+
+	return(type < UT_ARR_SIZE(page_codecs)
+	       && page_codecs[type].decompress != NULL
+	       && page_codecs[type].decompress(
+		       safe, src, src_len, dst, dst_len));
+}
+
 /**
 @param[in]      type            The compression type
 @return the string representation */
 const char*
 Compression::to_string(Type type)
 {
-        switch(type) {
-        case NONE:
-                return("None");
-        case ZLIB:
-                return("Zlib");
-        case LZ4:
-                return("LZ4");
-        }
+	if (type < UT_ARR_SIZE(page_codecs)) {
+		return(page_codecs[type].name);
+	}
 
         ut_ad(0);
 
         return("<UNKNOWN>");
 }
 
+/** Get the algorithm that is written to the header of the pages
+compressed with an algorithm.
+@param[in]	type		compression algorithm
+@return the algorithm that decompresses the pages */
+Compression::Type
+Compression::stored_type(Type type)
+{
+	ut_ad(type < UT_ARR_SIZE(page_codecs));
+
+	return(page_codecs[type].stored_type);
+}
+
 /**
 @param[in]      meta		Page Meta data
 @return the string representation */
@@ -8167,69 +8365,15 @@ Compression::deserialize(
 		allocated = false;
 	}
 
-	int		ret;
 	Compression	compression;
 	ulint		len = header.m_original_size;
 
 	compression.m_type = static_cast<Compression::Type>(header.m_algorithm);
 
-	switch(compression.m_type) {
-	case Compression::ZLIB: {
-
-		uLongf	zlen = header.m_original_size;
-
-		if (uncompress(dst, &zlen, ptr, header.m_compressed_size)
-		    != Z_OK) {
-
-			if (allocated) {
-				ut_free(dst);
-			}
-
-			return(DB_IO_DECOMPRESS_FAIL);
-		}
-
-		len = static_cast<ulint>(zlen);
-
-		break;
-	}
-
-	case Compression::LZ4:
-
-		if (dblwr_recover) {
-
-			ret = LZ4_decompress_safe(
-				reinterpret_cast<char*>(ptr),
-				reinterpret_cast<char*>(dst),
-				header.m_compressed_size,
-				header.m_original_size);
-
-		} else {
-
-			/* This can potentially read beyond the input
-			buffer if the data is malformed. According to
-			the LZ4 documentation it is a little faster
-			than the above function. When recovering from
-			the double write buffer we can afford to us the
-			slower function above. */
-
-			ret = LZ4_decompress_fast(
-				reinterpret_cast<char*>(ptr),
-				reinterpret_cast<char*>(dst),
-				header.m_original_size);
-		}
-
-		if (ret < 0) {
-
-			if (allocated) {
-				ut_free(dst);
-			}
-
-			return(DB_IO_DECOMPRESS_FAIL);
-		}
-
-		break;
-
-	default:
+	/* Only the algorithms that are written to the page header
+	decompress. */
+	if (compression.m_type >= UT_ARR_SIZE(page_codecs)
+	    || page_codecs[compression.m_type].decompress == NULL) {
 #if !defined(UNIV_INNOCHECKSUM)
 		ib::error()
 			<< "Compression algorithm support missing: "
@@ -8246,6 +8390,37 @@ Compression::deserialize(
 		return(DB_UNSUPPORTED);
 	}
 
+#if !defined(UNIV_INNOCHECKSUM)
+	const ulint	type = compression.m_type - ZLIB;
+	const bool	monitor = MONITOR_IS_ON(
+		MONITOR_PAGE_CODEC_DECOMPRESSED_ZLIB + type);
+	uintmax_t	start_time = monitor ? ut_time_us(NULL) : 0;
+#endif /* !UNIV_INNOCHECKSUM */
+
+	/* When recovering from the double write buffer we can
+	afford to use the slower, safe decompression. */
+	if (!decompress(compression.m_type, dblwr_recover,
+			ptr, header.m_compressed_size, dst, len)) {
+
+		if (allocated) {
+			ut_free(dst);
+		}
+
+		return(DB_IO_DECOMPRESS_FAIL);
+	}
+
+#if !defined(UNIV_INNOCHECKSUM)
+	if (monitor) {
+		MONITOR_INC_NOCHECK(
+			monitor_id_t(MONITOR_PAGE_CODEC_DECOMPRESSED_ZLIB
+				     + type));
+		MONITOR_INC_VALUE(
+			monitor_id_t(MONITOR_PAGE_CODEC_DECOMPRESS_TIME_ZLIB
+				     + type),
+			ut_time_us(NULL) - start_time);
+	}
+#endif /* !UNIV_INNOCHECKSUM */
+
 	/* Leave the header alone */
 	memmove(src + FIL_PAGE_DATA, dst, len);
 
@@ -45,6 +45,10 @@ SysMutex	thread_mutex;
 /** Number of threads active. */
 ulint	os_thread_count;
 
+/** Number of threads reserved by OSThreadGroup; protected by
+thread_mutex */
+static ulint	os_thread_n_workers;
+
 #ifdef _WIN32
 typedef std::map<
 	DWORD,
@@ -290,6 +294,88 @@ os_thread_active()
 	return(active);
 }
 
+/** Wait for the threads that are still running. */
+OSThreadGroup::~OSThreadGroup()
+{
+	join();
+
+	if (m_event != NULL) {
+		os_event_destroy(m_event);
+	}
+}
+
+/** Reserve a thread in OS_THREAD_MAX_N_WORKERS.
+@return false if all the threads are in use */
+bool
+OSThreadGroup::reserve()
+{
+	mutex_enter(&thread_mutex);
+
+	if (os_thread_n_workers >= OS_THREAD_MAX_N_WORKERS) {
+		mutex_exit(&thread_mutex);
+		return(false);
+	}
+
+	++os_thread_n_workers;
+	++m_n_running;
+
+	mutex_exit(&thread_mutex);
+
+	if (m_event == NULL) {
+		m_event = os_event_create(0);
+	}
+
+	++m_n_started;
+
+	return(true);
+}
+
+/** Exit the calling thread of the group. This must be the last
+access of the thread to data that the starting thread may free
+after join(). */
+void
+OSThreadGroup::exit()
+{
+	mutex_enter(&thread_mutex);
+
+	ut_ad(m_n_running > 0);
+
+	if (--m_n_running == 0) {
+		os_event_set(m_event);
+	}
+
+	mutex_exit(&thread_mutex);
+
+	os_thread_exit(NULL);
+}
+
+/** Wait until every thread that was started has called exit(),
+and return the threads to OS_THREAD_MAX_N_WORKERS. */
+void
+OSThreadGroup::join()
+{
+	if (m_n_started == 0) {
+		return;
+	}
+
+	os_event_wait(m_event);
+
+	/* The last thread sets m_event while holding thread_mutex.
+	Once we have acquired thread_mutex, no thread of the group
+	accesses this object any more. */
+	mutex_enter(&thread_mutex);
+
+	ut_ad(m_n_running == 0);
+	ut_ad(os_thread_n_workers >= m_n_started);
+
+	os_thread_n_workers -= m_n_started;
+
+	mutex_exit(&thread_mutex);
+
+	m_n_started = 0;
+	os_event_reset(m_event);
+}
+
 /**
 Initializes OS thread management data structures. */
 void
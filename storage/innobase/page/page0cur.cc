@@ -503,6 +503,19 @@ page_cur_search_with_match(
 	up_matched_fields  = *iup_matched_fields;
 	low_matched_fields = *ilow_matched_fields;
 
+	/* Copy the leading fields that can be compared with memcmp(),
+	so that most comparisons need neither rec_get_offsets() nor
+	cmp_dtuple_rec_with_match(). */
+	const ulint		comp = page_is_comp(page);
+	const ulint		n_cmp = dtuple_get_n_fields_cmp(tuple);
+	cmp_memcmp_key_t	key;
+
+	if (index->rec_cache.n_memcmp_fields) {
+		cmp_memcmp_key_init(&key, tuple, index);
+	} else {
+		key.n_fields = 0;
+	}
+
 	/* Perform binary search. First the search is done through the page
 	directory, after that as a linear search in the list of records
 	owned by the upper limit directory slot. */
@@ -521,22 +534,29 @@ page_cur_search_with_match(
 		cur_matched_fields = std::min(low_matched_fields,
 					      up_matched_fields);
 
-		offsets = offsets_;
-		if (index->rec_cache.fixed_len_key) {
-			offsets = populate_offsets(
-				mid_rec, tuple,
-				const_cast<dict_index_t*>(index),
-				offsets, &heap);
+		if (cur_matched_fields < key.n_fields
+		    && ((cmp = cmp_memcmp_key_rec_with_match(
+				 &key, mid_rec, comp, &cur_matched_fields))
+			|| cur_matched_fields == n_cmp)) {
+			/* The order was resolved by the leading
+			fixed-length fields. */
 		} else {
-			offsets = rec_get_offsets(
-				mid_rec, index, offsets,
-				dtuple_get_n_fields_cmp(tuple), &heap);
+			offsets = offsets_;
+			if (index->rec_cache.fixed_len_key) {
+				offsets = populate_offsets(
+					mid_rec, tuple,
+					const_cast<dict_index_t*>(index),
+					offsets, &heap);
+			} else {
+				offsets = rec_get_offsets(
+					mid_rec, index, offsets,
+					n_cmp, &heap);
+			}
 
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets, &cur_matched_fields);
 		}
 
-		cmp = cmp_dtuple_rec_with_match(
-			tuple, mid_rec, offsets, &cur_matched_fields);
-
 		if (cmp > 0) {
 low_slot_match:
 			low = mid;
@@ -583,22 +603,29 @@ up_slot_match:
 		cur_matched_fields = std::min(low_matched_fields,
 					      up_matched_fields);
 
-		offsets = offsets_;
-		if (index->rec_cache.fixed_len_key) {
-			offsets = populate_offsets(
-				mid_rec, tuple,
-				const_cast<dict_index_t*>(index),
-				offsets, &heap);
+		if (cur_matched_fields < key.n_fields
+		    && ((cmp = cmp_memcmp_key_rec_with_match(
+				 &key, mid_rec, comp, &cur_matched_fields))
+			|| cur_matched_fields == n_cmp)) {
+			/* The order was resolved by the leading
+			fixed-length fields. */
 		} else {
-			offsets = rec_get_offsets(
-				mid_rec, index, offsets,
-				dtuple_get_n_fields_cmp(tuple), &heap);
+			offsets = offsets_;
+			if (index->rec_cache.fixed_len_key) {
+				offsets = populate_offsets(
+					mid_rec, tuple,
+					const_cast<dict_index_t*>(index),
+					offsets, &heap);
+			} else {
+				offsets = rec_get_offsets(
+					mid_rec, index, offsets,
+					n_cmp, &heap);
+			}
 
+			cmp = cmp_dtuple_rec_with_match(
+				tuple, mid_rec, offsets, &cur_matched_fields);
 		}
 
-		cmp = cmp_dtuple_rec_with_match(
-			tuple, mid_rec, offsets, &cur_matched_fields);
-
 		if (cmp > 0) {
 low_rec_match:
 			low_rec = mid_rec;
@@ -630,7 +657,7 @@ up_rec_match:
 				/* We got a match, but cur_matched_fields is
 				0, it must have REC_INFO_MIN_REC_FLAG */
 				ulint   rec_info = rec_get_info_bits(mid_rec,
-                                                     rec_offs_comp(offsets));
+								 comp);
 				ut_ad(rec_info & REC_INFO_MIN_REC_FLAG);
 				ut_ad(btr_page_get_prev(page, &mtr) == FIL_NULL);
 				mtr_commit(&mtr);
@@ -325,7 +325,8 @@ ReadView::ReadView()
 	m_up_limit_id(),
 	m_creator_trx_id(),
 	m_ids(),
-	m_low_limit_no()
+	m_low_limit_no(),
+	m_version()
 {
 	ut_d(::memset(&m_view_list, 0x0, sizeof(m_view_list)));
 }
@@ -438,6 +439,8 @@ ReadView::prepare(trx_id_t id)
 
 	m_low_limit_no = m_low_limit_id = trx_sys->max_trx_id;
 
+	m_version = trx_sys->rw_trx_ids_version;
+
 	if (!trx_sys->rw_trx_ids.empty()) {
 		copy_trx_ids(trx_sys->rw_trx_ids);
 	} else {
@@ -545,19 +548,24 @@ MVCC::view_open(ReadView*& view, trx_t* trx)
 
 		ut_ad(view->m_closed);
 
-		/* NOTE: This can be optimised further, for now we only
-		resuse the view iff there are no active RW transactions.
+		/* The view can be reused without acquiring
+		trx_sys->mutex iff the set of active RW transactions has
+		not changed since it was created: every RW transaction
+		start and commit bumps trx_sys->rw_trx_ids_version.
 
 		There is an inherent race here between purge and this
 		thread. Purge will skip views that are marked as closed.
-		Therefore we must set the low limit id after we reset the
-		closed status after the check. */
+		Therefore we must check the version after we have reset
+		the closed status, and the store must be visible before
+		the version is read. */
 
-		if (trx_is_autocommit_non_locking(trx) && view->empty()) {
+		if (trx_is_autocommit_non_locking(trx)) {
 
 			view->m_closed = false;
 
-			if (view->m_low_limit_id == trx_sys_get_max_trx_id()) {
+			os_mb;
+
+			if (view->m_version == trx_sys->rw_trx_ids_version) {
 				return;
 			} else {
 				view->m_closed = true;
@@ -637,6 +645,8 @@ ReadView::copy_prepare(const ReadView& other)
 	m_low_limit_id = other.m_low_limit_id;
 
 	m_creator_trx_id = other.m_creator_trx_id;
+
+	m_version = other.m_version;
 }
 
 /**
@@ -155,6 +155,138 @@ cmp_cols_are_equal(
 	return(col1->mtype != DATA_INT || col1->len == col2->len);
 }
 
+/** Determine if values of a data type are ordered as their stored bytes,
+so that they can be compared with memcmp().
+@param[in]	mtype	main type
+@param[in]	prtype	precise type
+@return whether the type is ordered by memcmp() */
+bool
+cmp_type_is_memcmp(
+	ulint	mtype,
+	ulint	prtype)
+{
+	switch (mtype) {
+	case DATA_FIXBINARY:
+	case DATA_BINARY:
+		return(dtype_get_charset_coll(prtype)
+		       == DATA_MYSQL_BINARY_CHARSET_COLL);
+	case DATA_INT:
+		/* Integers are stored big-endian, and the sign bit
+		of signed integers is inverted. */
+	case DATA_SYS_CHILD:
+	case DATA_SYS:
+		return(true);
+	}
+
+	return(false);
+}
+
+/** Copy the leading fields of a search tuple that can be compared with
+memcmp() to a search key.
+@param[out]	key	search key
+@param[in]	dtuple	search tuple
+@param[in]	index	B-tree index */
+void
+cmp_memcmp_key_init(
+	cmp_memcmp_key_t*	key,
+	const dtuple_t*		dtuple,
+	const dict_index_t*	index)
+{
+	ulint	n_fields = std::min(dtuple_get_n_fields_cmp(dtuple),
+				    index->rec_cache.n_memcmp_fields);
+	ulint	len = 0;
+
+	key->n_fields = 0;
+
+	if (dtuple_get_info_bits(dtuple) & REC_INFO_MIN_REC_FLAG) {
+		return;
+	}
+
+	for (ulint i = 0; i < n_fields; i++) {
+		const dfield_t*	dfield = dtuple_get_nth_field(dtuple, i);
+		ulint		f_len = dfield_get_len(dfield);
+
+		ut_ad(!dfield_is_ext(dfield));
+		ut_ad(cmp_type_is_memcmp(dfield_get_type(dfield)->mtype,
+					 dfield_get_type(dfield)->prtype));
+
+		/* A shorter field, such as a column prefix in the
+		search tuple, or SQL NULL must be compared by
+		cmp_dtuple_rec_with_match(). */
+		if (f_len != dict_index_get_nth_field(index, i)->fixed_len
+		    || len + f_len > sizeof key->key) {
+			break;
+		}
+
+		memcpy(key->key + len, dfield_get_data(dfield), f_len);
+		len += f_len;
+		key->field_end[key->n_fields++] = len;
+	}
+}
+
+/** Compare the leading fields of a search tuple to a physical record.
+@param[in]	key		search key, with key->n_fields > 0
+@param[in]	rec		B-tree record
+@param[in]	comp		nonzero=compact record format
+@param[in,out]	matched_fields	number of completely matched fields;
+must be less than key->n_fields
+@return the comparison result of key and rec
+@retval 0 if the key->n_fields leading fields are equal
+@retval negative if key is less than rec
+@retval positive if key is greater than rec */
+int
+cmp_memcmp_key_rec_with_match(
+	const cmp_memcmp_key_t*	key,
+	const rec_t*		rec,
+	ulint			comp,
+	ulint*			matched_fields)
+{
+	ulint		cur_field = *matched_fields;
+	const ulint	len = key->field_end[key->n_fields - 1];
+
+	ut_ad(cur_field < key->n_fields);
+
+	if (cur_field == 0
+	    && UNIV_UNLIKELY(rec_get_info_bits(rec, comp)
+			     & REC_INFO_MIN_REC_FLAG)) {
+		/* The search key never has REC_INFO_MIN_REC_FLAG,
+		see cmp_memcmp_key_init(). */
+		return(1);
+	}
+
+	/* The fields are NOT NULL and of fixed length, so that they
+	are stored back to back from the record origin, in both record
+	formats. Skip the fields that are known to match, and compare
+	the rest a word at a time until the first differing byte. */
+	ulint	i = cur_field ? key->field_end[cur_field - 1] : 0;
+
+	for (; i + sizeof(ib_uint64_t) <= len; i += sizeof(ib_uint64_t)) {
+		ib_uint64_t	a;
+		ib_uint64_t	b;
+
+		memcpy(&a, key->key + i, sizeof a);
+		memcpy(&b, rec + i, sizeof b);
+
+		if (a != b) {
+			break;
+		}
+	}
+
+	for (; i < len; i++) {
+		if (key->key[i] != rec[i]) {
+			while (key->field_end[cur_field] <= i) {
+				cur_field++;
+			}
+
+			*matched_fields = cur_field;
+			return(int(key->key[i]) - int(rec[i]));
+		}
+	}
+
+	*matched_fields = key->n_fields;
+	return(0);
+}
+
 /** Compare two DATA_DECIMAL (MYSQL_TYPE_DECIMAL) fields.
 TODO: Remove this function. Everything should use MYSQL_TYPE_NEWDECIMAL.
 @param[in] a data field
@@ -3286,6 +3286,10 @@ row_ins_sec_index_entry(
 			dup_chk_only);
 	}
 
+	if (err == DB_SUCCESS && !dup_chk_only) {
+		index->stat_modified_counter++;
+	}
+
 	mem_heap_free(heap);
 	mem_heap_free(offsets_heap);
 	return(err);
@@ -1073,6 +1073,8 @@ row_merge_read(
 
 	if (err != DB_SUCCESS) {
 		ib::error() << "Failed to read merge block at " << ofs;
+	} else {
+		MONITOR_ATOMIC_INC(MONITOR_ALTER_TABLE_SORT_READS);
 	}
 
 	DBUG_RETURN(err == DB_SUCCESS);
@@ -1110,6 +1112,10 @@ row_merge_write(
 	posix_fadvise(fd, ofs, buf_len, POSIX_FADV_DONTNEED);
 #endif /* POSIX_FADV_DONTNEED */
 
+	if (err == DB_SUCCESS) {
+		MONITOR_ATOMIC_INC(MONITOR_ALTER_TABLE_SORT_WRITES);
+	}
+
 	DBUG_RETURN(err == DB_SUCCESS);
 }
 
@@ -2640,12 +2646,53 @@ wait_again:
 	ROW_MERGE_WRITE_GET_NEXT_LOW(N, INDEX, AT_END)
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
-/** Merge two blocks of records on disk and write a bigger block.
+/** Determine whether the current record of one input of a multi-way
+merge is to be written before the current record of another input.
+An exhausted input loses to every other input.
+@param[in]	index	index being created
+@param[in]	table	MySQL table, for reporting duplicates, or NULL
+@param[in]	mrec	current records of the inputs
+@param[in]	offsets	offsets of mrec[]
+@param[in]	a	input number
+@param[in]	b	input number
+@param[in,out]	dup	set to true if the records are equal
+@return true if input a wins over input b */
+static
+bool
+row_merge_beats(
+	const dict_index_t*	index,
+	struct TABLE*		table,
+	const mrec_t**		mrec,
+	ulint**			offsets,
+	ulint			a,
+	ulint			b,
+	bool*			dup)
+{
+	if (mrec[b] == NULL) {
+		return(true);
+	} else if (mrec[a] == NULL) {
+		return(false);
+	}
+
+	int	cmp = cmp_rec_rec_simple(
+		mrec[a], mrec[b], offsets[a], offsets[b], index, table);
+
+	if (cmp == 0) {
+		*dup = true;
+	}
+
+	return(cmp < 0);
+}
+
+/** Merge several lists of records on disk into one list, using a loser
+tree to select the next record to write. Input i is read through
+block[i * srv_sort_buf_size], and the output is written through
+block[n * srv_sort_buf_size].
 @param[in]	dup	descriptor of index being created
 @param[in]	file	file containing index entries
-@param[in,out]	block	3 buffers
-@param[in,out]	foffs0	offset of first source list in the file
-@param[in,out]	foffs1	offset of second source list in the file
+@param[in,out]	block	n + 1 buffers
+@param[in,out]	foffs	offsets of the source lists in the file
+@param[in]	n	number of source lists, at least 2
 @param[in,out]	of	output file
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL stage->inc() will be called for each record
@@ -2657,93 +2704,145 @@ row_merge_blocks(
 	const row_merge_dup_t*	dup,
 	const merge_file_t*	file,
 	row_merge_block_t*	block,
-	ulint*			foffs0,
-	ulint*			foffs1,
+	ulint*			foffs,
+	ulint			n,
 	merge_file_t*		of,
 	ut_stage_alter_t*	stage)
 {
-	mem_heap_t*	heap;	/*!< memory heap for offsets0, offsets1 */
-
-	mrec_buf_t*	buf;	/*!< buffer for handling
-				split mrec in block[] */
-	const byte*	b0;	/*!< pointer to block[0] */
-	const byte*	b1;	/*!< pointer to block[srv_sort_buf_size] */
-	byte*		b2;	/*!< pointer to block[2 * srv_sort_buf_size] */
-	const mrec_t*	mrec0;	/*!< merge rec, points to block[0] or buf[0] */
-	const mrec_t*	mrec1;	/*!< merge rec, points to
-				block[srv_sort_buf_size] or buf[1] */
-	ulint*		offsets0;/* offsets of mrec0 */
-	ulint*		offsets1;/* offsets of mrec1 */
+	const dict_index_t*	index	= dup->index;
+	const ulint	n_offs	= 1 + REC_OFFS_HEADER_SIZE
+		+ dict_index_get_n_fields(index);
+	mem_heap_t*	heap;	/*!< memory heap for the arrays below */
+	mrec_buf_t*	buf;	/*!< buffers for handling split mrec
+				in block[], one per input and output */
+	const byte**	b;	/*!< read pointers of the inputs */
+	const mrec_t**	mrec;	/*!< current records of the inputs */
+	ulint**		offsets;/*!< offsets of mrec[] */
+	ulint*		tree;	/*!< loser tree; tree[0] is the winner */
+	ulint*		win;	/*!< winners while building the tree */
+	byte*		bo;	/*!< pointer to the output block */
+	bool		is_dup	= false;
 
 	DBUG_ENTER("row_merge_blocks");
 	DBUG_PRINT("ib_merge_sort",
-		   ("fd=%d,%lu+%lu to fd=%d,%lu",
-		    file->fd, ulong(*foffs0), ulong(*foffs1),
+		   ("fd=%d,%lu..(%lu) to fd=%d,%lu",
+		    file->fd, ulong(foffs[0]), ulong(n),
 		    of->fd, ulong(of->offset)));
 
-	heap = row_merge_heap_create(dup->index, &buf, &offsets0, &offsets1);
+	ut_ad(n >= 2);
 
-	/* Write a record and read the next record.  Split the output
-	file in two halves, which can be merged on the following pass. */
+	heap = mem_heap_create((n + 1) * sizeof *buf
+			       + n * (n_offs + 5) * sizeof(ulint));
 
-	if (!row_merge_read(file->fd, *foffs0, &block[0])
-	    || !row_merge_read(file->fd, *foffs1, &block[srv_sort_buf_size])) {
-corrupt:
-		mem_heap_free(heap);
-		DBUG_RETURN(DB_CORRUPTION);
-	}
+	buf = static_cast<mrec_buf_t*>(
+		mem_heap_alloc(heap, (n + 1) * sizeof *buf));
+	b = static_cast<const byte**>(mem_heap_alloc(heap, n * sizeof *b));
+	mrec = static_cast<const mrec_t**>(
+		mem_heap_alloc(heap, n * sizeof *mrec));
+	offsets = static_cast<ulint**>(
+		mem_heap_alloc(heap, n * sizeof *offsets));
+	tree = static_cast<ulint*>(mem_heap_alloc(heap, n * sizeof *tree));
+	win = static_cast<ulint*>(mem_heap_alloc(heap, 2 * n * sizeof *win));
 
-	b0 = &block[0];
-	b1 = &block[srv_sort_buf_size];
-	b2 = &block[2 * srv_sort_buf_size];
+	for (ulint i = 0; i < n; i++) {
+		row_merge_block_t*	ib = &block[i * srv_sort_buf_size];
 
-	b0 = row_merge_read_rec(
-		&block[0], &buf[0], b0, dup->index,
-		file->fd, foffs0, &mrec0, offsets0);
-	b1 = row_merge_read_rec(
-		&block[srv_sort_buf_size],
-		&buf[srv_sort_buf_size], b1, dup->index,
-		file->fd, foffs1, &mrec1, offsets1);
-	if (UNIV_UNLIKELY(!b0 && mrec0)
-	    || UNIV_UNLIKELY(!b1 && mrec1)) {
+		offsets[i] = static_cast<ulint*>(
+			mem_heap_alloc(heap, n_offs * sizeof **offsets));
+		offsets[i][0] = n_offs;
+		offsets[i][1] = dict_index_get_n_fields(index);
 
-		goto corrupt;
+		if (!row_merge_read(file->fd, foffs[i], ib)) {
+			goto corrupt;
+		}
+
+		b[i] = row_merge_read_rec(ib, &buf[i], ib, index,
+					  file->fd, &foffs[i],
+					  &mrec[i], offsets[i]);
+
+		if (UNIV_UNLIKELY(!b[i] && mrec[i])) {
+			goto corrupt;
+		}
+	}
+
+	/* Play the initial tournament. The leaves of the tree are the
+	inputs, at win[n..2n-1]. Each inner node keeps the loser of
+	its match and passes the winner on towards the root. */
+	for (ulint i = 0; i < n; i++) {
+		win[n + i] = i;
 	}
 
-	while (mrec0 && mrec1) {
-		int cmp = cmp_rec_rec_simple(
-			mrec0, mrec1, offsets0, offsets1,
-			dup->index, dup->table);
-		if (cmp < 0) {
-			ROW_MERGE_WRITE_GET_NEXT(0, dup->index, goto merged);
-		} else if (cmp) {
-			ROW_MERGE_WRITE_GET_NEXT(1, dup->index, goto merged);
+	for (ulint node = n - 1; node > 0; node--) {
+		ulint	l = win[2 * node];
+		ulint	r = win[2 * node + 1];
+
+		if (row_merge_beats(index, dup->table, mrec, offsets,
+				    l, r, &is_dup)) {
+			win[node] = l;
+			tree[node] = r;
 		} else {
-			mem_heap_free(heap);
-			DBUG_RETURN(DB_DUPLICATE_KEY);
+			win[node] = r;
+			tree[node] = l;
 		}
 	}
 
-merged:
-	if (mrec0) {
-		/* append all mrec0 to output */
-		for (;;) {
-			ROW_MERGE_WRITE_GET_NEXT(0, dup->index, goto done0);
+	tree[0] = win[1];
+	bo = &block[n * srv_sort_buf_size];
+
+	while (!is_dup && mrec[tree[0]] != NULL) {
+		ulint	w = tree[0];
+
+#ifdef HAVE_PSI_STAGE_INTERFACE
+		if (stage != NULL) {
+			stage->inc();
 		}
-	}
-done0:
-	if (mrec1) {
-		/* append all mrec1 to output */
-		for (;;) {
-			ROW_MERGE_WRITE_GET_NEXT(1, dup->index, goto done1);
+#endif /* HAVE_PSI_STAGE_INTERFACE */
+
+		bo = row_merge_write_rec(&block[n * srv_sort_buf_size],
+					 &buf[n], bo, of->fd, &of->offset,
+					 mrec[w], offsets[w]);
+
+		if (UNIV_UNLIKELY(!bo || ++of->n_rec > file->n_rec)) {
+			goto corrupt;
 		}
+
+		b[w] = row_merge_read_rec(&block[w * srv_sort_buf_size],
+					  &buf[w], b[w], index,
+					  file->fd, &foffs[w],
+					  &mrec[w], offsets[w]);
+
+		if (UNIV_UNLIKELY(!b[w] && mrec[w])) {
+			goto corrupt;
+		}
+
+		/* Replay the matches on the path from the leaf of
+		input w to the root. */
+		for (ulint node = (n + w) / 2; node > 0; node /= 2) {
+			if (row_merge_beats(index, dup->table, mrec, offsets,
+					    tree[node], w, &is_dup)) {
+				ulint	loser = w;
+
+				w = tree[node];
+				tree[node] = loser;
+			}
+		}
+
+		tree[0] = w;
+	}
+
+	mem_heap_free(heap);
+
+	if (is_dup) {
+		DBUG_RETURN(DB_DUPLICATE_KEY);
 	}
-done1:
 
+	bo = row_merge_write_eof(&block[n * srv_sort_buf_size],
+				 bo, of->fd, &of->offset);
+	DBUG_RETURN(bo ? DB_SUCCESS : DB_CORRUPTION);
+
+corrupt:
 	mem_heap_free(heap);
-	b2 = row_merge_write_eof(&block[2 * srv_sort_buf_size],
-				 b2, of->fd, &of->offset);
-	DBUG_RETURN(b2 ? DB_SUCCESS : DB_CORRUPTION);
+	DBUG_RETURN(DB_CORRUPTION);
 }
 
 /** Copy a block of index entries.
@@ -2823,17 +2922,20 @@ done0:
 }
 
 /** Merge disk files.
-@param[in]	trx		transaction
+@param[in]	trx		transaction, or NULL in a merge sort thread
 @param[in]	dup		descriptor of index being created
 @param[in,out]	file		file containing index entries
-@param[in,out]	block		3 buffers
+@param[in,out]	block		ways + 1 buffers
 @param[in,out]	tmpfd		temporary file handle
 @param[in,out]	num_run		Number of runs that remain to be merged
 @param[in,out]	run_offset	Array that contains the first offset number
 for each merge run
+@param[in]	ways		maximum number of runs to merge into one
 @param[in,out]	stage		performance schema accounting object, used by
 ALTER TABLE. If not NULL stage->inc() will be called for each record
 processed.
+@param[in]	aborted		flag that the ALTER TABLE thread sets to stop
+a merge sort thread, or NULL to check trx instead
 @return DB_SUCCESS or error code */
 static
 dberr_t
@@ -2845,91 +2947,72 @@ row_merge(
 	int*			tmpfd,
 	ulint*			num_run,
 	ulint*			run_offset,
-	ut_stage_alter_t*	stage)
+	ulint			ways,
+	ut_stage_alter_t*	stage,
+	const volatile bool*	aborted)
 {
-	ulint		foffs0;	/*!< first input offset */
-	ulint		foffs1;	/*!< second input offset */
+	ulint		foffs[ROW_MERGE_MAX_WAYS];
+				/*!< input offsets */
 	dberr_t		error;	/*!< error code */
 	merge_file_t	of;	/*!< output file */
-	const ulint	ihalf	= run_offset[*num_run / 2];
-				/*!< half the input file */
 	ulint		n_run	= 0;
 				/*!< num of runs generated from this merge */
 
-	UNIV_MEM_ASSERT_W(&block[0], 3 * srv_sort_buf_size);
+	UNIV_MEM_ASSERT_W(&block[0], (ways + 1) * srv_sort_buf_size);
 
-	ut_ad(ihalf < file->offset);
+	ut_ad(ways >= 2);
+	ut_ad(ways <= ROW_MERGE_MAX_WAYS);
+	ut_ad(*num_run > 1);
 
 	of.fd = *tmpfd;
 	of.offset = 0;
 	of.n_rec = 0;
 
 #ifdef POSIX_FADV_SEQUENTIAL
-	/* The input file will be read sequentially, starting from the
-	beginning and the middle.  In Linux, the POSIX_FADV_SEQUENTIAL
-	affects the entire file.  Each block will be read exactly once. */
+	/* Each input run will be read sequentially. In Linux, the
+	POSIX_FADV_SEQUENTIAL affects the entire file.  Each block
+	will be read exactly once. */
 	posix_fadvise(file->fd, 0, 0,
 		      POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE);
 #endif /* POSIX_FADV_SEQUENTIAL */
 
-	/* Merge blocks to the output file. */
-	foffs0 = 0;
-	foffs1 = ihalf;
-
-	UNIV_MEM_INVALID(run_offset, *num_run * sizeof *run_offset);
-
-	for (; foffs0 < ihalf && foffs1 < file->offset; foffs0++, foffs1++) {
+	/* Merge each group of up to "ways" consecutive runs into one
+	run of the output file. */
+	for (ulint run = 0; run < *num_run; run += ways) {
+		ulint	n = ut_min(ways, *num_run - run);
 
-		if (trx_is_interrupted(trx)) {
+		if (aborted != NULL ? *aborted : trx_is_interrupted(trx)) {
 			return(DB_INTERRUPTED);
 		}
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
-
-		error = row_merge_blocks(dup, file, block,
-					 &foffs0, &foffs1, &of, stage);
-
-		if (error != DB_SUCCESS) {
-			return(error);
+		/* Read the input offsets before run_offset[] is
+		overwritten with the start of the output run. */
+		for (ulint i = 0; i < n; i++) {
+			foffs[i] = run_offset[run + i];
 		}
 
-	}
-
-	/* Copy the last blocks, if there are any. */
-
-	while (foffs0 < ihalf) {
-		if (UNIV_UNLIKELY(trx_is_interrupted(trx))) {
-			return(DB_INTERRUPTED);
-		}
+		ut_ad(n_run <= run);
 
 		/* Remember the offset number for this run */
 		run_offset[n_run++] = of.offset;
 
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs0, &of, stage)) {
-			return(DB_CORRUPTION);
-		}
-	}
-
-	ut_ad(foffs0 == ihalf);
+		if (n == 1) {
+			if (!row_merge_blocks_copy(dup->index, file, block,
+						   &foffs[0], &of, stage)) {
+				return(DB_CORRUPTION);
+			}
 
-	while (foffs1 < file->offset) {
-		if (trx_is_interrupted(trx)) {
-			return(DB_INTERRUPTED);
+			continue;
 		}
 
-		/* Remember the offset number for this run */
-		run_offset[n_run++] = of.offset;
+		error = row_merge_blocks(dup, file, block,
+					 foffs, n, &of, stage);
 
-		if (!row_merge_blocks_copy(dup->index, file, block,
-					   &foffs1, &of, stage)) {
-			return(DB_CORRUPTION);
+		if (error != DB_SUCCESS) {
+			return(error);
 		}
 	}
 
-	ut_ad(foffs1 == file->offset);
-
 	if (UNIV_UNLIKELY(of.n_rec != file->n_rec)) {
 		return(DB_CORRUPTION);
 	}
@@ -2952,13 +3035,15 @@ row_merge(
 	*tmpfd = file->fd;
 	*file = of;
 
-	UNIV_MEM_INVALID(&block[0], 3 * srv_sort_buf_size);
+	UNIV_MEM_INVALID(&block[0], (ways + 1) * srv_sort_buf_size);
 
 	return(DB_SUCCESS);
 }
 
-/** Merge disk files.
-@param[in]	trx	transaction
+/** Merge disk files. Up to innodb_sort_merge_ways runs are merged
+in each pass; the buffers for merging more than two runs at a time are
+allocated here.
+@param[in]	trx	transaction, or NULL in a merge sort thread
 @param[in]	dup	descriptor of index being created
 @param[in,out]	file	file containing index entries
 @param[in,out]	block	3 buffers
@@ -2966,6 +3051,8 @@ row_merge(
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. If not NULL, stage->begin_phase_sort() will be called initially
 and then stage->inc() will be called for each record processed.
+@param[in]	aborted	flag that the ALTER TABLE thread sets to stop a merge
+sort thread, or NULL to check whether trx was interrupted instead
 @return DB_SUCCESS or error code */
 dberr_t
 row_merge_sort(
@@ -2974,19 +3061,32 @@ row_merge_sort(
 	merge_file_t*		file,
 	row_merge_block_t*	block,
 	int*			tmpfd,
-	ut_stage_alter_t*	stage /* = NULL */)
+	ut_stage_alter_t*	stage /* = NULL */,
+	const volatile bool*	aborted /* = NULL */)
 {
-	const ulint	half	= file->offset / 2;
 	ulint		num_runs;
 	ulint*		run_offset;
+	ulint		ways	= srv_sort_merge_ways;
+	row_merge_block_t*	merge_block = block;
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t	merge_block_pfx;
 	dberr_t		error	= DB_SUCCESS;
 	DBUG_ENTER("row_merge_sort");
 
 	/* Record the number of merge runs we need to perform */
 	num_runs = file->offset;
 
+	/* Merging more runs than there are does not save a pass. */
+	if (ways > num_runs) {
+		ways = num_runs;
+	}
+
+	if (ways < 2) {
+		ways = 2;
+	}
+
 	if (stage != NULL) {
-		stage->begin_phase_sort(log2(num_runs));
+		stage->begin_phase_sort(log2(num_runs) / log2(ways));
 	}
 
 	/* If num_runs are less than 1, nothing to merge */
@@ -2994,12 +3094,24 @@ row_merge_sort(
 		DBUG_RETURN(error);
 	}
 
+	/* The caller only provides buffers for a two-way merge. */
+	if (ways > 2) {
+		merge_block = alloc.allocate_large(
+			(ways + 1) * srv_sort_buf_size, &merge_block_pfx);
+
+		if (merge_block == NULL) {
+			merge_block = block;
+			ways = 2;
+		}
+	}
+
 	/* "run_offset" records each run's first offset number */
 	run_offset = (ulint*) ut_malloc_nokey(file->offset * sizeof(ulint));
 
-	/* This tells row_merge() where to start for the first round
-	of merge. */
-	run_offset[half] = half;
+	/* Initially, each block of the file is a run of its own. */
+	for (ulint i = 0; i < num_runs; i++) {
+		run_offset[i] = i;
+	}
 
 	/* The file should always contain at least one byte (the end
 	of file marker).  Thus, it must be at least one block. */
@@ -3007,8 +3119,9 @@ row_merge_sort(
 
 	/* Merge the runs until we have one big run */
 	do {
-		error = row_merge(trx, dup, file, block, tmpfd,
-				  &num_runs, run_offset, stage);
+		error = row_merge(trx, dup, file, merge_block, tmpfd,
+				  &num_runs, run_offset, ways, stage,
+				  aborted);
 
 		if (error != DB_SUCCESS) {
 			break;
@@ -3019,6 +3132,10 @@ row_merge_sort(
 
 	ut_free(run_offset);
 
+	if (merge_block != block) {
+		alloc.deallocate_large(merge_block, &merge_block_pfx);
+	}
+
 	DBUG_RETURN(error);
 }
 
@@ -4226,6 +4343,172 @@ row_merge_drop_table(
 					trx, false, false));
 }
 
+/** Background merge sort of the secondary index files created by
+row_merge_read_clustered_index(). The threads take the files in index
+order and sort each with their own buffers and temporary file, so that
+the sort of one index overlaps the bulk load of the indexes preceding
+it. When the table is being rebuilt, the threads also bulk load the
+indexes that they sorted, each into its own BtrBulk. */
+struct row_merge_psort_t {
+	trx_id_t		trx_id;	/*!< transaction id */
+	const dict_table_t*	old_table;/*!< table where rows are read
+					from, or NULL if the sorted indexes
+					are loaded by the ALTER TABLE thread */
+	FlushObserver*		flush_observer;/*!< flush observer of
+					the bulk load */
+	dict_index_t**		indexes;/*!< indexes being created */
+	merge_file_t*		files;	/*!< merge files of indexes[] */
+	dberr_t*		errors;	/*!< per index sort (and load)
+					result */
+	volatile bool*		sorted;	/*!< per index completion flags */
+	const bool*		assigned;/*!< indexes sorted in background */
+	const volatile bool*	aborted;/*!< set by the ALTER TABLE thread
+					when index creation failed or was
+					interrupted */
+	ulint			n_indexes;/*!< size of indexes[] */
+	volatile ulint		next;	/*!< number of indexes that have
+					been taken by the threads; may
+					exceed n_indexes */
+	os_event_t		event;	/*!< set when an index is sorted */
+	OSThreadGroup*		threads;/*!< the merge sort threads */
+};
+
+/** Check whether the entries of an index can be merge sorted outside
+the thread that is executing ALTER TABLE.
+@param[in]	index	index being created
+@param[in]	file	merge file of index
+@param[in]	load	whether the background thread would also load
+the index
+@return true if the index can be sorted in a background thread */
+static
+bool
+row_merge_sort_in_background(
+	const dict_index_t*	index,
+	const merge_file_t*	file,
+	bool			load)
+{
+	/* Duplicates of a unique index are reported through the
+	MySQL record buffer, which only the ALTER TABLE thread may
+	access. */
+	return(file->fd >= 0
+	       && (load || file->offset > 1)
+	       && !dict_index_is_spatial(index)
+	       && !(index->type & DICT_FTS)
+	       && !dict_index_is_unique(index));
+}
+
+/** Merge sort thread. Sorts, and when rebuilding the table also loads,
+the indexes that were assigned to the background sort until none are
+left.
+@param[in,out]	arg	row_merge_psort_t
+@return a dummy parameter */
+extern "C"
+os_thread_ret_t
+DECLARE_THREAD(row_merge_sort_thread)(
+	void*	arg)
+{
+	row_merge_psort_t*	psort = static_cast<row_merge_psort_t*>(arg);
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t		block_pfx;
+	row_merge_block_t*	block;
+	int			tmpfd = -1;
+
+	block = alloc.allocate_large(3 * srv_sort_buf_size, &block_pfx);
+
+	for (;;) {
+		ulint	i = os_atomic_increment_ulint(&psort->next, 1) - 1;
+
+		if (i >= psort->n_indexes) {
+			break;
+		}
+
+		if (!psort->assigned[i]) {
+			continue;
+		}
+
+		if (*psort->aborted) {
+			psort->errors[i] = DB_INTERRUPTED;
+		} else if (block == NULL) {
+			psort->errors[i] = DB_OUT_OF_MEMORY;
+		} else {
+			row_merge_dup_t	dup = {
+				psort->indexes[i], NULL, NULL, 0};
+
+			/* The transaction belongs to the ALTER TABLE
+			thread, which also notices its interruption. */
+			psort->errors[i] = row_merge_sort(
+				NULL, &dup, &psort->files[i],
+				block, &tmpfd, NULL, psort->aborted);
+
+			if (psort->errors[i] == DB_SUCCESS
+			    && psort->old_table != NULL) {
+				BtrBulk	btr_bulk(psort->indexes[i],
+						 psort->trx_id,
+						 psort->flush_observer,
+						 psort->aborted);
+				btr_bulk.init();
+
+				dberr_t	err = row_merge_insert_index_tuples(
+					psort->trx_id, psort->indexes[i],
+					psort->old_table, psort->files[i].fd,
+					block, NULL, &btr_bulk);
+
+				psort->errors[i] = btr_bulk.finish(err);
+			}
+		}
+
+		/* Publish errors[i] and files[i] before the flag. */
+		os_wmb;
+		psort->sorted[i] = true;
+		os_event_set(psort->event);
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block != NULL) {
+		alloc.deallocate_large(block, &block_pfx);
+	}
+
+	psort->threads->exit();
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/** Wait until a merge sort thread has sorted an index. Stop the merge
+sort threads if the ALTER TABLE is interrupted meanwhile.
+@param[in]	trx	transaction
+@param[in]	event	sort event
+@param[in]	flag	completion flag of the index
+@param[out]	aborted	flag that stops the merge sort threads */
+static
+void
+row_merge_sort_wait(
+	trx_t*			trx,
+	os_event_t		event,
+	const volatile bool*	flag,
+	volatile bool*		aborted)
+{
+	while (!*flag) {
+		int64_t	sig_count = os_event_reset(event);
+
+		if (*flag) {
+			break;
+		}
+
+		if (!*aborted && trx_is_interrupted(trx)) {
+			*aborted = true;
+		}
+
+		/* The threads set the event when an index is sorted;
+		the timeout is only for noticing the interruption. */
+		os_event_wait_time_low(event, 100000, sig_count);
+	}
+
+	/* Pairs with the os_wmb in row_merge_psort_thread(): the
+	error and the merge file of the index are visible now. */
+	os_rmb;
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4280,6 +4563,14 @@ row_merge_build_indexes(
 	fts_psort_t*		merge_info = NULL;
 	int64_t			sig_count = 0;
 	bool			fts_psort_initiated = false;
+	row_merge_psort_t*	psort = NULL;
+	ulint			n_psort = 0;
+	bool*			psort_assigned = NULL;
+	dberr_t*		psort_errors = NULL;
+	volatile bool*		psort_sorted = NULL;
+	volatile bool		psort_aborted = false;
+	os_event_t		psort_event = NULL;
+	OSThreadGroup		psort_threads;
 	DBUG_ENTER("row_merge_build_indexes");
 
 	ut_ad(!srv_read_only_mode);
@@ -4393,7 +4684,65 @@ row_merge_build_indexes(
 	DEBUG_SYNC_C("row_merge_after_scan");
 
 	/* Now we have files containing index entries ready for
-	sorting and inserting. */
+	sorting and inserting. Let background threads sort the entries
+	of the secondary indexes while the ALTER TABLE thread is
+	inserting into the indexes that come before them. When the
+	table is rebuilt, no log is applied to the individual indexes,
+	and the background threads load the indexes as well. */
+
+	if (srv_sort_pll_degree > 1) {
+		psort_assigned = static_cast<bool*>(
+			ut_zalloc_nokey(n_indexes * sizeof *psort_assigned));
+
+		for (i = 0; i < n_indexes; i++) {
+			if (row_merge_sort_in_background(
+				    indexes[i], &merge_files[i],
+				    old_table != new_table)) {
+				psort_assigned[i] = true;
+				n_psort++;
+			}
+		}
+
+		n_psort = ut_min(n_psort, srv_sort_pll_degree - 1);
+	}
+
+	if (n_psort > 0) {
+		psort = static_cast<row_merge_psort_t*>(
+			ut_zalloc_nokey(sizeof *psort));
+		psort_errors = static_cast<dberr_t*>(
+			ut_zalloc_nokey(n_indexes * sizeof *psort_errors));
+		psort_sorted = static_cast<bool*>(
+			ut_zalloc_nokey(n_indexes * sizeof *psort_sorted));
+		psort_event = os_event_create(0);
+
+		psort->trx_id = trx->id;
+		psort->old_table = old_table != new_table ? old_table : NULL;
+		psort->flush_observer = flush_observer;
+		psort->indexes = indexes;
+		psort->files = merge_files;
+		psort->errors = psort_errors;
+		psort->sorted = psort_sorted;
+		psort->assigned = psort_assigned;
+		psort->aborted = &psort_aborted;
+		psort->n_indexes = n_indexes;
+		psort->next = 0;
+		psort->event = psort_event;
+		psort->threads = &psort_threads;
+
+		for (j = 0; j < n_psort; j++) {
+			if (!psort_threads.start(row_merge_sort_thread,
+						 psort)) {
+				break;
+			}
+		}
+
+		if (j == 0) {
+			/* No thread could be started; sort all the
+			indexes in the ALTER TABLE thread. */
+			memset(psort_assigned, 0,
+			       n_indexes * sizeof *psort_assigned);
+		}
+	}
 
 	for (i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
@@ -4471,11 +4820,21 @@ wait_again:
 			row_merge_dup_t	dup = {
 				sort_idx, table, col_map, 0};
 
-			error = row_merge_sort(
-				trx, &dup, &merge_files[i],
-				block, &tmpfd, stage);
+			bool	loaded = false;
 
-			if (error == DB_SUCCESS) {
+			if (n_psort > 0 && psort_assigned[i]) {
+				row_merge_sort_wait(
+					trx, psort_event, &psort_sorted[i],
+					&psort_aborted);
+				error = psort_errors[i];
+				loaded = old_table != new_table;
+			} else {
+				error = row_merge_sort(
+					trx, &dup, &merge_files[i],
+					block, &tmpfd, stage);
+			}
+
+			if (error == DB_SUCCESS && !loaded) {
 				BtrBulk	btr_bulk(sort_idx, trx->id,
 						 flush_observer);
 				btr_bulk.init();
@@ -4528,6 +4887,20 @@ func_exit:
 		error = DB_TOO_MANY_CONCURRENT_TRXS;
 		trx->error_state = error;);
 
+	if (n_psort > 0) {
+		/* The sort threads access merge_files[]. */
+		psort_aborted = true;
+
+		psort_threads.join();
+
+		os_event_destroy(psort_event);
+		ut_free(const_cast<bool*>(psort_sorted));
+		ut_free(psort_errors);
+		ut_free(psort);
+	}
+
+	ut_free(psort_assigned);
+
 	if (fts_psort_initiated) {
 		/* Clean up FTS psort related resource */
 		row_fts_psort_info_destroy(psort_info, merge_info);
@@ -1031,8 +1031,6 @@ row_purge_end(
 
 	thr->run_node = que_node_get_parent(node);
 
-	node->undo_recs = NULL;
-
 	node->done = TRUE;
 
 	ut_a(thr->run_node != NULL);
@@ -1068,21 +1066,23 @@ row_purge_step(
 
 	ut_ad(que_node_get_type(node) == QUE_NODE_PURGE);
 
-	if (!(node->undo_recs == NULL || ib_vector_is_empty(node->undo_recs))) {
+	/* Take the next record of the batch that no purge thread has
+	taken yet. */
+	ulint	i = os_atomic_increment_ulint(&purge_sys->next_rec, 1) - 1;
+
+	if (i < ib_vector_size(purge_sys->undo_recs)) {
 		trx_purge_rec_t*purge_rec;
 
 		purge_rec = static_cast<trx_purge_rec_t*>(
-			ib_vector_pop(node->undo_recs));
+			ib_vector_get(purge_sys->undo_recs, i));
 
 		node->roll_ptr = purge_rec->roll_ptr;
 
 		row_purge(node, purge_rec->undo_rec, thr);
 
-		if (ib_vector_is_empty(node->undo_recs)) {
-			row_purge_end(thr);
-		} else {
-			thr->run_node = node;
-		}
+		++node->n_recs;
+
+		thr->run_node = node;
 	} else {
 		row_purge_end(thr);
 	}
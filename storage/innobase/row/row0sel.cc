@@ -1654,7 +1654,7 @@ table_loop:
 	    && !plan->must_get_clust
 	    && !plan->table->big_rows) {
 		if (!search_latch_locked) {
-			rw_lock_s_lock(btr_get_search_latch(index));
+			btr_search_s_lock(index);
 
 			search_latch_locked = TRUE;
 		} else if (rw_lock_get_writer(btr_get_search_latch(index))
@@ -1668,7 +1668,7 @@ table_loop:
 			performance significantly in multiprocessors. */
 
 			rw_lock_s_unlock(btr_get_search_latch(index));
-			rw_lock_s_lock(btr_get_search_latch(index));
+			btr_search_s_lock(index);
 		}
 
 		found_flag = row_sel_try_search_shortcut(node, plan,
@@ -3822,7 +3822,7 @@ row_sel_dequeue_cached_row_for_mysql(
 }
 
 /********************************************************************//**
-Initialise the prefetch cache. */
+Initialise the prefetch cache for prebuilt->fetch_cache_size rows. */
 UNIV_INLINE
 void
 row_sel_prefetch_cache_init(
@@ -3833,11 +3833,21 @@ row_sel_prefetch_cache_init(
 	ulint	sz;
 	byte*	ptr;
 
+	ut_ad(prebuilt->fetch_cache_size <= MYSQL_FETCH_CACHE_MAX_SIZE);
+
+	if (prebuilt->fetch_cache[0] != NULL) {
+		/* Grow the cache. It is empty between batches. */
+		ut_ad(prebuilt->n_fetch_cached == 0);
+		ut_free(prebuilt->fetch_cache[0] - 4);
+	}
+
+	prebuilt->fetch_cache_alloc = prebuilt->fetch_cache_size;
+
 	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
+	sz = prebuilt->fetch_cache_alloc * (prebuilt->mysql_row_len + 8);
 	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	for (i = 0; i < prebuilt->fetch_cache_alloc; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3864,9 +3874,9 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
+	if (prebuilt->fetch_cache_alloc < prebuilt->fetch_cache_size) {
 		/* Allocate memory for the fetch cache */
 		ut_ad(prebuilt->n_fetch_cached == 0);
 
@@ -3880,6 +3890,26 @@ row_sel_fetch_last_buf(
 	return(prebuilt->fetch_cache[prebuilt->n_fetch_cached]);
 }
 
+/** Double the number of rows to fetch into the prefetch cache in the
+next batch, up to MYSQL_FETCH_CACHE_MAX_SIZE rows or
+MYSQL_FETCH_CACHE_MAX_BYTES of row buffers.
+@param[in,out]	prebuilt	prebuilt struct */
+UNIV_INLINE
+void
+row_sel_grow_fetch_cache(
+	row_prebuilt_t*	prebuilt)
+{
+	ulint	max_size = MYSQL_FETCH_CACHE_MAX_BYTES
+		/ (prebuilt->mysql_row_len + 8);
+
+	max_size = ut_min(max_size, ulint(MYSQL_FETCH_CACHE_MAX_SIZE));
+
+	if (prebuilt->fetch_cache_size < max_size) {
+		prebuilt->fetch_cache_size = ut_min(
+			2 * prebuilt->fetch_cache_size, max_size);
+	}
+}
+
 /********************************************************************//**
 Pushes a row for MySQL to the fetch cache. */
 UNIV_INLINE
@@ -4558,6 +4588,7 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -4582,6 +4613,7 @@ row_search_mvcc(
 			prebuilt->n_rows_fetched = 0;
 			prebuilt->n_fetch_cached = 0;
 			prebuilt->fetch_cache_first = 0;
+			prebuilt->fetch_cache_size = MYSQL_FETCH_CACHE_SIZE;
 
 		} else if (UNIV_LIKELY(prebuilt->n_fetch_cached > 0)) {
 			row_sel_dequeue_cached_row_for_mysql(buf, prebuilt);
@@ -4593,7 +4625,8 @@ row_search_mvcc(
 		}
 
 		if (prebuilt->fetch_cache_first > 0
-		    && prebuilt->fetch_cache_first < MYSQL_FETCH_CACHE_SIZE) {
+		    && prebuilt->fetch_cache_first
+		    < prebuilt->fetch_cache_size) {
 
 			/* The previous returned row was popped from the fetch
 			cache, but the cache was not full at the time of the
@@ -4698,7 +4731,7 @@ row_search_mvcc(
 			hash index semaphore! */
 
 			ut_a(!trx->has_search_latch);
-			rw_lock_s_lock(btr_get_search_latch(index));
+			btr_search_s_lock(index);
 			trx->has_search_latch = true;
 
 			switch (row_sel_try_search_shortcut_for_mysql(
@@ -5643,7 +5676,7 @@ requires_clust_rec:
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_size);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5696,10 +5729,17 @@ requires_clust_rec:
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_size) {
 			goto next_rec;
 		}
 
+		/* The batch is full. If the cursor keeps consuming
+		whole batches, it is scanning a long range: fetch more
+		rows per page latch in the next batch. The cursor position
+		is stored and the page latch released in between, as
+		before. */
+		row_sel_grow_fetch_cache(prebuilt);
+
 	} else {
 		if (UNIV_UNLIKELY
 		    (prebuilt->template_type == ROW_MYSQL_DUMMY_TEMPLATE)) {
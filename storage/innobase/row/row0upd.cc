@@ -2210,12 +2210,17 @@ row_upd_sec_index_entry(
 
 	if (node->is_delete || err != DB_SUCCESS) {
 
+		if (err == DB_SUCCESS) {
+			index->stat_modified_counter++;
+		}
+
 		goto func_exit;
 	}
 
 	mem_heap_empty(heap);
 
-	/* Build a new index entry */
+	/* Build a new index entry; row_ins_sec_index_entry() counts
+	the modification when the insert succeeds */
 	entry = row_build_index_entry(node->upd_row, node->upd_ext,
 				      index, heap);
 	ut_a(entry);
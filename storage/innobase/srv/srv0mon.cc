@@ -569,6 +569,18 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_SEARCH},
 
+	{"buffer_LRU_get_free_single_flush", "buffer",
+	 "Number of times a user thread found no free block and had to"
+	 " flush a page from the LRU list itself",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_GET_FREE_SINGLE_FLUSH},
+
+	{"buffer_LRU_free_target", "buffer",
+	 "Number of free blocks the last LRU flush of a buffer pool"
+	 " instance tried to keep on its free list",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_LRU_FREE_TARGET},
+
 	/* Cumulative counter for LRU search scans */
 	{"buffer_LRU_search_scanned", "buffer",
 	 "Total pages scanned as part of LRU search",
@@ -848,6 +860,23 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DISPLAY_CURRENT,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_RESUME_COUNT},
 
+	{"purge_batch_records", "purge",
+	 "Number of undo log records in the last purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_BATCH_RECORDS},
+
+	{"purge_batch_max_thread_records", "purge",
+	 "Most undo log records purged by one purge thread"
+	 " in the last purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_BATCH_THREAD_MAX},
+
+	{"purge_history_len_change", "purge",
+	 "Change of the history list length since the previous"
+	 " purge batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_HISTORY_LEN_CHANGE},
+
 	/* ========== Counters for Recovery Module ========== */
 	{"module_log", "recovery", "Recovery Module",
 	 MONITOR_MODULE,
@@ -931,6 +960,16 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_EXISTING | MONITOR_DEFAULT_ON),
 	 MONITOR_DEFAULT_START, MONITOR_OVLD_LOG_PADDED},
 
+	{"log_flusher_flushes", "recovery",
+	 "Number of log flushes done by the log_flusher thread",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSHER_FLUSHES},
+
+	{"log_flusher_waits", "recovery",
+	 "Number of times a commit waited for the log_flusher thread",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_LOG_FLUSHER_WAITS},
+
 	/* ========== Counters for Page Compression ========== */
 	{"module_compress", "compression", "Page Compression Info",
 	 MONITOR_MODULE,
@@ -955,6 +994,71 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_PAD_DECREMENTS},
 
+	{"page_codec_zlib_compressed", "compression",
+	 "Number of pages compressed with zlib",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_COMPRESSED_ZLIB},
+
+	{"page_codec_lz4_compressed", "compression",
+	 "Number of pages compressed with LZ4",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_COMPRESSED_LZ4},
+
+	{"page_codec_lz4hc_compressed", "compression",
+	 "Number of pages compressed with LZ4HC",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_COMPRESSED_LZ4HC},
+
+	{"page_codec_zlib_compress_usec", "compression",
+	 "Time spent compressing pages with zlib (in micro-seconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_COMPRESS_TIME_ZLIB},
+
+	{"page_codec_lz4_compress_usec", "compression",
+	 "Time spent compressing pages with LZ4 (in micro-seconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_COMPRESS_TIME_LZ4},
+
+	{"page_codec_lz4hc_compress_usec", "compression",
+	 "Time spent compressing pages with LZ4HC (in micro-seconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_COMPRESS_TIME_LZ4HC},
+
+	{"page_codec_zlib_bytes_saved", "compression",
+	 "Bytes saved by compressing pages with zlib",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_SAVED_ZLIB},
+
+	{"page_codec_lz4_bytes_saved", "compression",
+	 "Bytes saved by compressing pages with LZ4",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_SAVED_LZ4},
+
+	{"page_codec_lz4hc_bytes_saved", "compression",
+	 "Bytes saved by compressing pages with LZ4HC",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_SAVED_LZ4HC},
+
+	{"page_codec_zlib_decompressed", "compression",
+	 "Number of pages decompressed with zlib",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_DECOMPRESSED_ZLIB},
+
+	{"page_codec_lz4_decompressed", "compression",
+	 "Number of pages decompressed with LZ4",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_DECOMPRESSED_LZ4},
+
+	{"page_codec_zlib_decompress_usec", "compression",
+	 "Time spent decompressing pages with zlib (in micro-seconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_DECOMPRESS_TIME_ZLIB},
+
+	{"page_codec_lz4_decompress_usec", "compression",
+	 "Time spent decompressing pages with LZ4 (in micro-seconds)",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PAGE_CODEC_DECOMPRESS_TIME_LZ4},
+
 	/* ========== Counters for Index ========== */
 	{"module_index", "index", "Index Manager",
 	 MONITOR_MODULE,
@@ -1037,6 +1141,12 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_ROW_UPDATED},
 
+	{"adaptive_hash_latch_waits", "adaptive_hash_index",
+	 "Number of times an Adaptive Hash Index partition latch"
+	 " was not immediately available",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ADAPTIVE_HASH_LATCH_WAITS},
+
 	/* ========== Counters for tablespace ========== */
 	{"module_file", "file_system", "Tablespace and File System Manager",
 	 MONITOR_MODULE,
@@ -1294,6 +1404,21 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_NONE,
 	 MONITOR_DEFAULT_START, MONITOR_ALTER_TABLE_LOG_FILES},
 
+	/* ===== Counters for Index Creation Merge Sort Module ===== */
+	{"module_ddl_sort", "ddl_sort", "Index creation merge sort",
+	 MONITOR_MODULE,
+	 MONITOR_DEFAULT_START, MONITOR_MODULE_DDL_SORT},
+
+	{"ddl_sort_file_blocks_read", "ddl_sort",
+	 "Number of innodb_sort_buffer_size blocks read from sort files",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ALTER_TABLE_SORT_READS},
+
+	{"ddl_sort_file_blocks_written", "ddl_sort",
+	 "Number of innodb_sort_buffer_size blocks written to sort files",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_ALTER_TABLE_SORT_WRITES},
+
 	/* ===== Counters for ICP (Index Condition Pushdown) Module ===== */
 	{"module_icp", "icp", "Index Condition Pushdown",
 	 MONITOR_MODULE,
@@ -162,6 +162,11 @@ on duplicate key checking and foreign key checking */
 ibool	srv_locks_unsafe_for_binlog = FALSE;
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size = 1048576;
+/** Number of threads used to merge sort secondary index entries in
+index creation */
+ulong	srv_sort_pll_degree = 4;
+/** Maximum number of sorted runs merged in one pass of row_merge_sort() */
+ulong	srv_sort_merge_ways = 8;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -300,6 +305,9 @@ ulong	srv_flushing_avg_loops		= 30;
 /* The number of purge threads to use.*/
 ulong	srv_n_purge_threads = 4;
 
+/* The number of threads applying redo log records during crash recovery. */
+ulong	srv_n_recv_apply_threads = 4;
+
 /* the number of pages to purge in one batch */
 ulong	srv_purge_batch_size = 20;
 
@@ -328,6 +336,10 @@ ulong	srv_force_recovery_crash;
 
 my_bool	srv_print_all_deadlocks = FALSE;
 
+/** Leave deadlock detection to the lock wait timeout thread instead of
+running it in the thread that enqueues a lock wait */
+my_bool	srv_deadlock_detect_async = FALSE;
+
 /** Enable INFORMATION_SCHEMA.innodb_cmp_per_index */
 my_bool	srv_cmp_per_index_enabled = FALSE;
 
@@ -350,6 +362,9 @@ unsigned long long	srv_stats_transient_sample_pages = 8;
 my_bool		srv_stats_persistent = TRUE;
 unsigned long long	srv_stats_persistent_sample_pages = 20;
 my_bool		srv_stats_auto_recalc = TRUE;
+/* Number of threads that analyze the indexes of a table in parallel
+when calculating persistent statistics */
+ulong		srv_stats_pll_degree = 4;
 
 ibool	srv_use_doublewrite_buf	= TRUE;
 
@@ -1231,6 +1246,17 @@ srv_printf_innodb_monitor(
 		rw_lock_s_lock(btr_search_latches[i]);
 		ha_print_info(file, btr_search_sys->hash_tables[i]);
 		rw_lock_s_unlock(btr_search_latches[i]);
+
+		const btr_search_part_stats_t*	stats
+			= &btr_search_sys->part_stats[i];
+
+		fprintf(file,
+			"hash searches %lu, hits %lu, misses %lu,"
+			" latch waits %lu\n",
+			(ulong) (stats->n_hits + stats->n_misses),
+			(ulong) stats->n_hits,
+			(ulong) stats->n_misses,
+			(ulong) stats->n_latch_waits);
 	}
 
 	fprintf(file,
@@ -1547,7 +1573,7 @@ loop:
 		if (srv_print_innodb_monitor) {
 			/* Reset mutex_skipped counter everytime
 			srv_print_innodb_monitor changes. This is to
-			ensure we will not be blocked by lock_sys->mutex
+			ensure we will not be blocked by lock_sys->latch
 			for short duration information printing,
 			such as requested by sync_array_print_long_waits() */
 			if (!last_srv_print_monitor) {
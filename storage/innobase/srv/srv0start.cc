@@ -1576,6 +1576,7 @@ innobase_start_or_create_for_mysql(void)
 
 	srv_max_n_threads = 1   /* io_ibuf_thread */
 			    + 1 /* io_log_thread */
+			    + 1 /* log_flusher_thread */
 			    + 1 /* lock_wait_timeout_thread */
 			    + 1 /* srv_error_monitor_thread */
 			    + 1 /* srv_monitor_thread */
@@ -1586,6 +1587,8 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
+			    + OS_THREAD_MAX_N_WORKERS /* parallel index
+				  sort, statistics and FTS query threads */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
 			    + max_connections
@@ -1593,6 +1596,7 @@ innobase_start_or_create_for_mysql(void)
 			    + srv_n_write_io_threads
 			    + srv_n_purge_threads
 			    + srv_n_page_cleaners
+			    + srv_n_recv_apply_threads
 			    /* FTS Parallel Sort */
 			    + fts_sort_pll_degree * FTS_NUM_AUX_INDEX
 			      * max_connections;
@@ -2414,6 +2418,14 @@ files_checked:
 			srv_monitor_thread,
 			NULL, thread_ids + 4 + SRV_MAX_N_IO_THREADS);
 
+		/* Create the thread which writes and flushes the log
+		for committing transactions. The flag is set here, and
+		not by the thread, so that a shutdown right after startup
+		waits for the thread to exit. */
+		log_flusher_thread_active = true;
+		os_wmb;
+		os_thread_create(log_flusher_thread, NULL, NULL);
+
 		srv_start_state_set(SRV_START_STATE_MONITOR);
 	}
 
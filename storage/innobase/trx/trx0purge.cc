@@ -264,6 +264,10 @@ trx_purge_sys_create(
 	purge_sys->view_active = true;
 
 	purge_sys->rseg_iter = UT_NEW_NOKEY(TrxUndoRsegsIterator(purge_sys));
+
+	purge_sys->heap = mem_heap_create(1024);
+
+	purge_sys->history_len = trx_sys->rseg_history_len;
 }
 
 /************************************************************************
@@ -300,6 +304,8 @@ trx_purge_sys_close(void)
 
 	UT_DELETE(purge_sys->rseg_iter);
 
+	mem_heap_free(purge_sys->heap);
+
 	ut_free(purge_sys);
 
 	purge_sys = NULL;
@@ -1599,7 +1605,6 @@ trx_purge_attach_undo_recs(
 	que_thr_t*	thr;
 	ulint		i = 0;
 	ulint		n_pages_handled = 0;
-	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
 
 	ut_a(n_purge_threads > 0);
 
@@ -1616,10 +1621,11 @@ trx_purge_attach_undo_recs(
 		node = (purge_node_t*) thr->child;
 
 		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
-		ut_a(node->undo_recs == NULL);
+		ut_a(!thr->is_active);
 		ut_a(node->done);
 
 		node->done = FALSE;
+		node->n_recs = 0;
 	}
 
 	/* There should never be fewer nodes than threads, the inverse
@@ -1627,26 +1633,20 @@ trx_purge_attach_undo_recs(
 	ut_a(i == n_purge_threads);
 
 	/* Fetch and parse the UNDO records. The UNDO records are added
-	to a per purge node vector. */
-	thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
-	ut_a(n_thrs > 0 && thr != NULL);
-
-	ut_ad(trx_purge_check_limit());
+	to the batch vector, from which the purge threads take them. All
+	the records of the previous batch have been purged. */
+	mem_heap_empty(purge_sys->heap);
 
-	i = 0;
+	purge_sys->undo_recs = ib_vector_create(
+		ib_heap_allocator_create(purge_sys->heap),
+		sizeof(trx_purge_rec_t), batch_size);
 
-	for (;;) {
-		purge_node_t*		node;
-		trx_purge_rec_t*	purge_rec;
-
-		ut_a(!thr->is_active);
+	purge_sys->next_rec = 0;
 
-		/* Get the purge node. */
-		node = (purge_node_t*) thr->child;
-		ut_a(que_node_get_type(node) == QUE_NODE_PURGE);
+	ut_ad(trx_purge_check_limit());
 
-		purge_rec = static_cast<trx_purge_rec_t*>(
-			mem_heap_zalloc(node->heap, sizeof(*purge_rec)));
+	for (;;) {
+		trx_purge_rec_t		purge_rec;
 
 		/* Track the max {trx_id, undo_no} for truncating the
 		UNDO logs once we have purged the records. */
@@ -1656,37 +1656,20 @@ trx_purge_attach_undo_recs(
 		}
 
 		/* Fetch the next record, and advance the purge_sys->iter. */
-		purge_rec->undo_rec = trx_purge_fetch_next_rec(
-			&purge_rec->roll_ptr, &n_pages_handled, node->heap);
-
-		if (purge_rec->undo_rec != NULL) {
-
-			if (node->undo_recs == NULL) {
-				node->undo_recs = ib_vector_create(
-					ib_heap_allocator_create(node->heap),
-					sizeof(trx_purge_rec_t),
-					batch_size);
-			} else {
-				ut_a(!ib_vector_is_empty(node->undo_recs));
-			}
-
-			ib_vector_push(node->undo_recs, purge_rec);
+		purge_rec.undo_rec = trx_purge_fetch_next_rec(
+			&purge_rec.roll_ptr, &n_pages_handled,
+			purge_sys->heap);
 
-			if (n_pages_handled >= batch_size) {
-
-				break;
-			}
-		} else {
+		if (purge_rec.undo_rec == NULL) {
 			break;
 		}
 
-		thr = UT_LIST_GET_NEXT(thrs, thr);
+		ib_vector_push(purge_sys->undo_recs, &purge_rec);
 
-		if (!(++i % n_purge_threads)) {
-			thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
-		}
+		if (n_pages_handled >= batch_size) {
 
-		ut_a(thr != NULL);
+			break;
+		}
 	}
 
 	ut_ad(trx_purge_check_limit());
@@ -1798,6 +1781,15 @@ trx_purge(
 
 	srv_dml_needed_delay = trx_purge_dml_delay();
 
+	/* Dirty read of the history list length, for the trend only. */
+	ulint	history_len = trx_sys->rseg_history_len;
+
+	MONITOR_SET(MONITOR_PURGE_HISTORY_LEN_CHANGE,
+		    mon_type_t(history_len)
+		    - mon_type_t(purge_sys->history_len));
+
+	purge_sys->history_len = history_len;
+
 	/* The number of tasks submitted should be completed. */
 	ut_a(purge_sys->n_submitted == purge_sys->n_completed);
 
@@ -1876,6 +1868,25 @@ run_synchronously:
 		trx_purge_truncate();
 	}
 
+	if (MONITOR_IS_ON(MONITOR_PURGE_BATCH_THREAD_MAX)) {
+		ulint	i = 0;
+		ulint	max_recs = 0;
+
+		for (thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
+		     thr != NULL && i < n_purge_threads;
+		     thr = UT_LIST_GET_NEXT(thrs, thr), ++i) {
+
+			const purge_node_t*	node
+				= static_cast<purge_node_t*>(thr->child);
+
+			max_recs = ut_max(max_recs, node->n_recs);
+		}
+
+		MONITOR_SET(MONITOR_PURGE_BATCH_THREAD_MAX, max_recs);
+	}
+
+	MONITOR_SET(MONITOR_PURGE_BATCH_RECORDS,
+		    ib_vector_size(purge_sys->undo_recs));
 	MONITOR_INC_VALUE(MONITOR_PURGE_INVOKED, 1);
 	MONITOR_INC_VALUE(MONITOR_PURGE_N_PAGE_HANDLED, n_pages_handled);
 
@@ -1311,6 +1311,8 @@ trx_assign_rseg(
 
 		trx_sys->rw_trx_ids.push_back(trx->id);
 
+		++trx_sys->rw_trx_ids_version;
+
 		trx_sys->rw_trx_set.insert(TrxTrack(trx->id, trx));
 
 		mutex_exit(&trx_sys->mutex);
@@ -1409,6 +1411,8 @@ trx_start_low(
 
 		trx_sys->rw_trx_ids.push_back(trx->id);
 
+		++trx_sys->rw_trx_ids_version;
+
 		trx_sys_rw_trx_add(trx);
 
 		ut_ad(trx->rsegs.m_redo.rseg != 0
@@ -1449,6 +1453,8 @@ trx_start_low(
 
 				trx_sys->rw_trx_ids.push_back(trx->id);
 
+				++trx_sys->rw_trx_ids_version;
+
 				trx_sys->rw_trx_set.insert(
 					TrxTrack(trx->id, trx));
 
@@ -1793,7 +1799,7 @@ trx_flush_log_if_needed_low(
 		/* fall through */
 	case 1:
 		/* Write the log and optionally flush it to disk */
-		log_write_up_to(lsn, flush);
+		log_wait_up_to(lsn, flush);
 		return;
 	case 0:
 		/* Do nothing */
@@ -1880,6 +1886,8 @@ trx_erase_from_write_set(trx_t* trx, bool serialised)
 	ut_ad(*it == trx->id);
 
 	trx_sys->rw_trx_ids.erase(it);
+
+	++trx_sys->rw_trx_ids_version;
 }
 
 /****************************************************************//**
@@ -2633,7 +2641,7 @@ state_ok:
 
 /**********************************************************************//**
 Prints info about a transaction.
-The caller must hold lock_sys->mutex and trx_sys->mutex.
+The caller must hold lock_sys->latch and trx_sys->mutex.
 When possible, use trx_print() instead. */
 void
 trx_print_latched(
@@ -2654,7 +2662,7 @@ trx_print_latched(
 
 /**********************************************************************//**
 Prints info about a transaction.
-Acquires and releases lock_sys->mutex and trx_sys->mutex. */
+Acquires and releases lock_sys->latch and trx_sys->mutex. */
 void
 trx_print(
 /*======*/
@@ -2700,7 +2708,7 @@ trx_assert_started(
 	/* trx->state can change from or to NOT_STARTED while we are holding
 	trx_sys->mutex for non-locking autocommit selects but not for other
 	types of transactions. It may change from ACTIVE to PREPARED. Unless
-	we are holding lock_sys->mutex, it may also change to COMMITTED. */
+	we are holding lock_sys->latch, it may also change to COMMITTED. */
 
 	switch (trx->state) {
 	case TRX_STATE_PREPARED:
@@ -2982,7 +2990,7 @@ This function is used to find one X/Open XA distributed transaction
 which is in the prepared state
 @return trx on match, the trx->xid will be invalidated;
 note that the trx may have been committed, unless the caller is
-holding lock_sys->mutex */
+holding lock_sys->latch */
 static __attribute__((warn_unused_result))
 trx_t*
 trx_get_trx_by_xid_low(
@@ -3024,7 +3032,7 @@ This function is used to find one X/Open XA distributed transaction
 which is in the prepared state
 @return trx or NULL; on match, the trx->xid will be invalidated;
 note that the trx may have been committed, unless the caller is
-holding lock_sys->mutex */
+holding lock_sys->latch */
 trx_t*
 trx_get_trx_by_xid(
 /*===============*/
@@ -3241,6 +3249,8 @@ trx_set_rw_mode(
 
 	trx_sys->rw_trx_ids.push_back(trx->id);
 
+	++trx_sys->rw_trx_ids_version;
+
 	trx_sys->rw_trx_set.insert(TrxTrack(trx->id, trx));
 
 	/* So that we can see our own changes. */
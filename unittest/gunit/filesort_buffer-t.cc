@@ -19,6 +19,8 @@
 #include <utility>
 
 #include "filesort_utils.h"
+#include "myisampack.h"
+#include "sql_sort.h"
 #include "table.h"
 
 
@@ -123,4 +125,28 @@ TEST_F(FileSortBufferTest, AssignmentOperator)
 }
 
 
+/*
+  Sort enough keys for several sort threads, and verify that the
+  runs sorted by each thread are merged into one sorted sequence.
+*/
+TEST_F(FileSortBufferTest, SortBufferThreads)
+{
+  const uint num_records= 4 * MIN_KEYS_PER_SORT_THREAD;
+  fs_info.alloc_sort_buffer(num_records, sizeof(int));
+  fs_info.init_next_record_pointer();
+  for (uint ix= 0; ix < num_records; ++ix)
+    mi_int4store(fs_info.get_next_record_pointer(),
+                 (ix * 7919) % num_records);
+
+  Sort_param param;
+  param.sort_length= sizeof(int);
+  param.sort_threads= 4;
+  fs_info.sort_buffer(&param, num_records);
+  for (uint ix= 0; ix < num_records; ++ix)
+  {
+    EXPECT_EQ(ix, mi_uint4korr(fs_info.get_sorted_record(ix)));
+  }
+}
+
+
 }  // namespace
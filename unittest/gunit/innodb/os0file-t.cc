@@ -0,0 +1,226 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/* See http://code.google.com/p/googletest/wiki/Primer */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gtest/gtest.h>
+
+#include "univ.i"
+
+#include "os0file.h"
+#include "ut0rnd.h"
+#include "ut0ut.h"
+
+namespace innodb_os0file_unittest {
+
+/** Size of the pages that are compressed */
+static const ulint	page_size = 16 * 1024;
+
+/** Compression levels used for the tests, zlib and LZ4HC honour them */
+static const ulint	levels[] = {1, 6, 9};
+
+/** The algorithms to test */
+static const Compression::Type	types[] = {
+	Compression::ZLIB,
+	Compression::LZ4,
+	Compression::LZ4HC
+};
+
+/** Fill a page with data that looks roughly like an index page:
+repeating records with a few changing bytes in each.
+@param[out]	page	page to fill */
+static
+void
+fill_page(byte* page)
+{
+	for (ulint i = 0; i < page_size; i++) {
+		page[i] = (i % 64 < 8)
+			? static_cast<byte>((i / 64) * 31)
+			: static_cast<byte>(i % 64);
+	}
+}
+
+/* Check that each algorithm decompresses what it compressed. */
+TEST(os0file, compress_roundtrip)
+{
+	byte*	page = new byte[page_size];
+	byte*	zip = new byte[page_size];
+	byte*	unzip = new byte[page_size];
+
+	fill_page(page);
+
+	for (ulint t = 0; t < UT_ARR_SIZE(types); t++) {
+		for (ulint l = 0; l < UT_ARR_SIZE(levels); l++) {
+
+			ulint	len = Compression::compress(
+				types[t], levels[l],
+				page, page_size, zip, page_size);
+
+			EXPECT_GT(len, 0U)
+				<< Compression::to_string(types[t]);
+			EXPECT_LT(len, page_size / 2)
+				<< Compression::to_string(types[t]);
+
+			/* Pages are decompressed with the algorithm
+			that is written to their header. */
+			for (ulint safe = 0; safe < 2; safe++) {
+
+				memset(unzip, 0, page_size);
+
+				EXPECT_TRUE(Compression::decompress(
+					Compression::stored_type(types[t]),
+					safe != 0,
+					zip, len, unzip, page_size))
+					<< Compression::to_string(types[t]);
+
+				EXPECT_EQ(0, memcmp(page, unzip, page_size))
+					<< Compression::to_string(types[t]);
+			}
+		}
+	}
+
+	delete[] unzip;
+	delete[] zip;
+	delete[] page;
+}
+
+/* Check that LZ4HC pages are marked as LZ4, which older servers and
+innochecksum can read. */
+TEST(os0file, stored_type)
+{
+	EXPECT_EQ(Compression::ZLIB,
+		  Compression::stored_type(Compression::ZLIB));
+	EXPECT_EQ(Compression::LZ4,
+		  Compression::stored_type(Compression::LZ4));
+	EXPECT_EQ(Compression::LZ4,
+		  Compression::stored_type(Compression::LZ4HC));
+}
+
+/* Check that a too small output buffer is reported as a failure. */
+TEST(os0file, compress_overflow)
+{
+	byte*	page = new byte[page_size];
+	byte*	zip = new byte[page_size];
+
+	/* Data that does not compress. */
+	for (ulint i = 0; i < page_size; i++) {
+		page[i] = static_cast<byte>(ut_rnd_gen_ulint());
+	}
+
+	for (ulint t = 0; t < UT_ARR_SIZE(types); t++) {
+
+		EXPECT_EQ(0U, Compression::compress(
+				  types[t], 6, page, page_size,
+				  zip, page_size / 2))
+			<< Compression::to_string(types[t]);
+	}
+
+	delete[] zip;
+	delete[] page;
+}
+
+/* Compress the pages of a real tablespace with each algorithm and
+print the compression ratio and speed. The file is given with the
+environment variable INNODB_PAGE_CODEC_BENCH_FILE and must use the
+default page size; the test is skipped when it is not set. */
+TEST(os0file, compress_bench)
+{
+	const char*	name = getenv("INNODB_PAGE_CODEC_BENCH_FILE");
+
+	if (name == NULL) {
+		return;
+	}
+
+	FILE*	file = fopen(name, "rb");
+
+	ASSERT_TRUE(file != NULL) << name;
+
+	byte*	page = new byte[page_size];
+	byte*	zip = new byte[page_size];
+	byte*	unzip = new byte[page_size];
+
+	for (ulint t = 0; t < UT_ARR_SIZE(types); t++) {
+		for (ulint l = 0; l < UT_ARR_SIZE(levels); l++) {
+
+			ulint		n_pages = 0;
+			ulint		n_compressed = 0;
+			ulint		zip_bytes = 0;
+			uintmax_t	compress_us = 0;
+			uintmax_t	decompress_us = 0;
+
+			rewind(file);
+
+			while (fread(page, 1, page_size, file) == page_size) {
+
+				uintmax_t	start = ut_time_us(NULL);
+
+				ulint	len = Compression::compress(
+					types[t], levels[l],
+					page, page_size, zip, page_size);
+
+				compress_us += ut_time_us(NULL) - start;
+
+				++n_pages;
+
+				if (len == 0) {
+					zip_bytes += page_size;
+					continue;
+				}
+
+				++n_compressed;
+				zip_bytes += len;
+
+				start = ut_time_us(NULL);
+
+				ASSERT_TRUE(Compression::decompress(
+					Compression::stored_type(types[t]),
+					false,
+					zip, len, unzip, page_size));
+
+				decompress_us += ut_time_us(NULL) - start;
+
+				ASSERT_EQ(0, memcmp(page, unzip, page_size));
+			}
+
+			if (n_pages == 0) {
+				continue;
+			}
+
+			printf("%-6s level %lu: %lu/%lu pages compressed,"
+			       " ratio %.2f, compress %lu us,"
+			       " decompress %lu us\n",
+			       Compression::to_string(types[t]),
+			       levels[l], n_compressed, n_pages,
+			       double(n_pages * page_size) / zip_bytes,
+			       static_cast<ulint>(compress_us),
+			       static_cast<ulint>(decompress_us));
+		}
+	}
+
+	delete[] unzip;
+	delete[] zip;
+	delete[] page;
+
+	fclose(file);
+}
+
+}
@@ -0,0 +1,140 @@
+/* Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "loser_tree.h"
+
+namespace loser_tree_unittest {
+
+/*
+  A sorted sequence of integers, with a cursor to the next one to merge.
+*/
+struct Run
+{
+  std::vector<int> keys;
+  size_t pos;
+
+  int current() const { return keys[pos]; }
+};
+
+
+/*
+  Orders runs like Merge_chunk_less in filesort: the run with the
+  smallest current key is at the top.
+*/
+struct Run_greater
+{
+  bool operator()(const Run *a, const Run *b) const
+  {
+    return a->current() > b->current();
+  }
+};
+
+
+class LoserTreeTest : public ::testing::Test
+{
+protected:
+  /*
+    Fills num_runs runs with a few sorted keys each, and merges them
+    through a Loser_tree.
+  */
+  void merge_runs(size_t num_runs)
+  {
+    std::vector<Run> runs(num_runs);
+    std::vector<int> expected;
+    for (size_t ix= 0; ix < num_runs; ++ix)
+    {
+      const size_t num_keys= 1 + (ix * 7) % 11;
+      for (size_t jx= 0; jx < num_keys; ++jx)
+        runs[ix].keys.push_back(static_cast<int>((ix * 31 + jx * 17) % 23));
+      std::sort(runs[ix].keys.begin(), runs[ix].keys.end());
+      runs[ix].pos= 0;
+      expected.insert(expected.end(),
+                      runs[ix].keys.begin(), runs[ix].keys.end());
+    }
+    std::sort(expected.begin(), expected.end());
+
+    Loser_tree<Run*, Run_greater> tree;
+    EXPECT_FALSE(tree.reserve(num_runs));
+    for (size_t ix= 0; ix < num_runs; ++ix)
+      EXPECT_FALSE(tree.push(&runs[ix]));
+    tree.build();
+
+    std::vector<int> merged;
+    while (!tree.empty())
+    {
+      Run *run= tree.top();
+      merged.push_back(run->current());
+      if (++run->pos == run->keys.size())
+        tree.pop();
+      else
+        tree.update_top();
+      EXPECT_EQ(tree.size(),
+                static_cast<size_t>(std::distance(tree.begin(), tree.end())));
+    }
+    EXPECT_EQ(expected, merged);
+  }
+};
+
+
+TEST_F(LoserTreeTest, OneRun)
+{
+  merge_runs(1);
+}
+
+
+TEST_F(LoserTreeTest, PowerOfTwoRuns)
+{
+  merge_runs(2);
+  merge_runs(16);
+}
+
+
+TEST_F(LoserTreeTest, OddRuns)
+{
+  merge_runs(3);
+  merge_runs(15);
+  merge_runs(33);
+}
+
+
+TEST_F(LoserTreeTest, IntegerTop)
+{
+  int keys[]= {10, 4, 7, 8, 21, -5, 6, 10, 7, 9};
+  Loser_tree<int> tree;
+  for (size_t ix= 0; ix < sizeof(keys) / sizeof(keys[0]); ++ix)
+    EXPECT_FALSE(tree.push(keys[ix]));
+  tree.build();
+  EXPECT_EQ(21, tree.top());
+
+  // Lower the winner's priority: the next greatest takes over.
+  tree.top()= 0;
+  tree.update_top();
+  EXPECT_EQ(10, tree.top());
+  tree.pop();
+  EXPECT_EQ(10, tree.top());
+  tree.pop();
+  EXPECT_EQ(9, tree.top());
+  EXPECT_EQ(8U, tree.size());
+}
+
+}